@@ -0,0 +1,236 @@
+#ifndef ARA_STAR_H
+#define ARA_STAR_H
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include "AStar.hpp"
+
+
+namespace PathFinding
+{
+    /// Anytime Repairing A*, finds a first solution fast with an inflated heuristic and keeps improving it while it runs,
+    /// deflating the heuristic on every iteration and reusing the work of the previous ones
+    class ARAStar : public AStar
+    {
+    private:
+        /// Inflation of the heuristic of the first iteration
+        double m_initialEpsilon;
+
+        /// Decrease of the inflation on every iteration
+        double m_epsilonStep;
+
+        /// Inflation of the heuristic of the current iteration
+        double m_epsilon = 1.f;
+
+        /// Bound of the cost of the current solution over the optimal one
+        double m_bound = std::numeric_limits<double>::max();
+
+        /// Number of solutions found on this run
+        size_t m_solutions = 0;
+
+        /// Nodes closed on the current iteration, so they can be reopened on the next one
+        std::vector<Node*> m_closedNodes;
+
+        /// Nodes improved after being closed on the current iteration, waiting for the next one
+        std::vector<Node*> m_inconsistentNodes;
+
+        /// Membership of every node on the open and the inconsistent collections
+        std::vector<std::uint8_t> m_lists;
+
+        enum List : std::uint8_t
+        {
+            None = 0,
+            Open = 1,
+            Inconsistent = 2
+        };
+
+    public:
+        /**
+         * Create a board with the size, start, and goal position given
+         *
+         * @param size Size of the board
+         * @param start Start position of the board
+         * @param goal Goal position of the board
+         * @param initialEpsilon Inflation of the heuristic of the first iteration, at least 1
+         * @param epsilonStep Decrease of the inflation on every iteration
+         */
+        ARAStar(const Coordinate& size, const Coordinate& start, const Coordinate& goal, const double initialEpsilon = 2.5, const double epsilonStep = 0.5)
+        : AStar(size, start, goal, "ARA*"), m_initialEpsilon(std::max(initialEpsilon, 1.)), m_epsilonStep(std::max(epsilonStep, 0.01)) {}
+
+        virtual ~ARAStar(){}
+
+        void init(const Heuristic heuristic, const bool diagonals = true, const bool cutCorners = true) override
+        {
+            m_epsilon = m_initialEpsilon;
+            m_bound = std::numeric_limits<double>::max();
+            m_solutions = 0;
+
+            m_closedNodes.clear();
+            m_inconsistentNodes.clear();
+            m_lists.assign(m_board.getTotalSize(), None);
+
+            AStar::init(heuristic, diagonals, cutCorners);
+
+            auto* start = m_board.getStartNode();
+            start->h = this->heuristic(start->position);
+            m_lists[getIndex(start)] = Open;
+        }
+
+        /**
+         * Returns the inflation of the heuristic of the current iteration
+         *
+         * @return Inflation of the heuristic
+         */
+        inline const double getEpsilon() const { return m_epsilon; }
+
+        /**
+         * Returns the bound of the cost of the current solution over the optimal one, 1 once it is optimal
+         *
+         * @return Bound of the suboptimality of the solution, max if there is no solution yet
+         */
+        inline const double getBound() const { return m_bound; }
+
+        /**
+         * Returns the number of solutions found, every one better than the previous one
+         *
+         * @return Number of solutions found
+         */
+        inline const size_t getSolutions() const { return m_solutions; }
+
+        /**
+         * Expands a node, or finishes the current iteration once its solution can't be improved
+         *
+         * @return Whether the algorithm finished, the solution is optimal or there is no solution
+         */
+        bool nextStep() override
+        {
+            sortNodes();
+
+            auto* goal = m_board[m_board.getGoal()];
+            const double goalCost = goal->opened ? goal->g : std::numeric_limits<double>::max();
+
+            if (m_openNodes.empty() || goalCost <= getKey(m_openNodes.back()))
+            {
+                return finishIteration(goalCost);
+            }
+
+            auto* node = closeNode();
+            m_lists[getIndex(node)] = None;
+            m_closedNodes.push_back(node);
+
+            std::vector<Node*> neighbors;
+            m_board.getNeighbors(node, neighbors, m_movement);
+            PATHFINDING_METRIC(metrics.neighborChecks += neighbors.size());
+
+            for (auto* neighbor : neighbors)
+            {
+                const auto g = node->g + moveCost(node->position, neighbor->position);
+                if (neighbor->opened && g >= neighbor->g) continue;
+
+                neighbor->g = g;
+                neighbor->h = heuristic(neighbor->position);
+
+                auto& list = m_lists[getIndex(neighbor)];
+                if (!neighbor->opened)
+                {
+                    openNode(neighbor, node);
+                    list = Open;
+                    continue;
+                }
+
+                PATHFINDING_METRIC(metrics.decreaseKeys += list == Open);
+                neighbor->parent = node;
+                markChanged(neighbor->position, Change::Parent);
+
+                // Closed nodes wait for the next iteration, the rest go back to the open ones
+                if (neighbor->closed && list != Inconsistent)
+                {
+                    m_inconsistentNodes.push_back(neighbor);
+                    list = Inconsistent;
+                }
+                else if (!neighbor->closed && list == None)
+                {
+                    m_openNodes.push_back(neighbor);
+                    list = Open;
+                    PATHFINDING_METRIC(++metrics.pushes);
+                }
+            }
+
+            PATHFINDING_METRIC(metrics.updateOpenNodes(m_openNodes.size() + m_inconsistentNodes.size(), sizeof(Node*)));
+            return false;
+        }
+
+    private:
+        inline size_t getIndex(const Node* node) const
+        {
+            return (size_t)node->position.first * m_board.getSize().second + node->position.second;
+        }
+
+        inline double getKey(const Node* node) const
+        {
+            return node->g + m_epsilon * node->h;
+        }
+
+        void sortNodes()
+        {
+            std::sort(m_openNodes.begin(), m_openNodes.end(), [this](const Node* node1, const Node* node2)
+            {
+                const auto key1 = getKey(node1), key2 = getKey(node2);
+                return key1 == key2 ? node1->h > node2->h : key1 > key2;
+            });
+        }
+
+        /**
+         * Stores the solution of the iteration, if any, and starts the next one with a smaller inflation
+         *
+         * @param goalCost Cost of the best path to the goal found
+         * @return Whether the algorithm finished or not
+         */
+        bool finishIteration(const double goalCost)
+        {
+            if (goalCost == std::numeric_limits<double>::max()) return true;
+
+            solution.clear();
+            storeSolution();
+            ++m_solutions;
+
+            // The optimal cost is at least the lowest unweighted cost of the nodes not expanded yet
+            double lowest = std::numeric_limits<double>::max();
+            for (const auto& nodes : { &m_openNodes, &m_inconsistentNodes })
+            {
+                for (const auto* node : *nodes)
+                {
+                    lowest = std::min(lowest, node->g + node->h);
+                }
+            }
+            m_bound = std::max(1., std::min(m_epsilon, lowest == std::numeric_limits<double>::max() ? 1. : goalCost / lowest));
+
+            if (m_epsilon <= 1.) return true;
+
+            m_epsilon = std::max(1., m_epsilon - m_epsilonStep);
+
+            // Every node can be expanded again, and the improved ones are evaluated again
+            for (auto* node : m_closedNodes)
+            {
+                node->closed = false;
+                markChanged(node->position, Change::Opened);
+            }
+            m_closedNodes.clear();
+
+            for (auto* node : m_inconsistentNodes)
+            {
+                m_openNodes.push_back(node);
+                m_lists[getIndex(node)] = Open;
+                PATHFINDING_METRIC(++metrics.pushes);
+                PATHFINDING_METRIC(++metrics.reopenings);
+            }
+            m_inconsistentNodes.clear();
+
+            return false;
+        }
+    };
+}
+
+#endif
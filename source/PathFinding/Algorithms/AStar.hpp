@@ -2,18 +2,19 @@
 #define A_STAR_H
 #pragma once
 
+#include <algorithm>
+#include <limits>
 #include "AlgorithmBase.hpp"
+#include "NeighborBatch.hpp"
 
 
 namespace PathFinding
 {
     class AStar : public AlgorithmBase
     {
+    protected:
         struct Node : NodeBase
         {
-            /// Whether the node has been evaluated or not.
-            bool closed = false;
-
             /// Heuristics calculations
             double h = std::numeric_limits<double>::max();
             double g = 0;
@@ -21,7 +22,6 @@ namespace PathFinding
             virtual void init() override
             {
                 NodeBase::init();
-                opened = false;
                 h = std::numeric_limits<double>::max();
                 g = 0;
             }
@@ -29,13 +29,11 @@ namespace PathFinding
             virtual void reset() override
             {
                 NodeBase::reset();
-                opened = false;
                 h = std::numeric_limits<double>::max();
                 g = 0;
             }
         };
         
-    protected:
         /// Collection of nodes yet to be evaluated.
         std::vector<Node*> m_openNodes;
         
@@ -51,7 +49,7 @@ namespace PathFinding
          * @param goal Goal position of the board
          */
         AStar(const Coordinate& size, const Coordinate& start, const Coordinate& goal)
-        : m_board{size, start, goal}, AlgorithmBase("A*") {}
+        : AStar(size, start, goal, "A*") {}
         
         virtual ~AStar(){}
         
@@ -69,6 +67,7 @@ namespace PathFinding
             m_openNodes.clear();
             
             m_board.init();
+            PATHFINDING_METRIC(metrics.boardMemory = m_board.getMemoryUsage());
             
             openNode(m_board.getStartNode());
         }
@@ -94,11 +93,23 @@ namespace PathFinding
         
         inline const bool isObstacle(const Coordinate& c) const override { return m_board.isObstacle(c); }
         
-        inline const void setObstacle(const Coordinate& c, const bool obstacle = true) const override
+        inline const NodeState getState(const Coordinate& c) const override { return m_board.getState(c); }
+        
+        inline void setObstacle(const Coordinate& c, const bool obstacle = true) override
         {
             m_board.setObstacle(c, obstacle);
         }
         
+        inline void setObstacles(const ObstacleGrid& obstacles) override { m_board.setObstacles(obstacles); }
+        
+        inline const Cost getCost(const Coordinate& c) const override { return m_board.getCost(c); }
+        
+        inline void setCost(const Coordinate& c, const Cost cost = 1) override { m_board.setCost(c, cost); }
+        
+        inline void setCosts(const std::vector<Cost>& costs) override { m_board.setCosts(costs); }
+        
+        inline const Cost getMinCost() const override { return m_board.getMinCost(); }
+        
         //TODO: Remove
         inline double getValue1(const Coordinate& c) const override
         {
@@ -119,28 +130,74 @@ namespace PathFinding
             
             auto* node = closeNode();
             
+            // The goal is checked once expanded, a node opened may still get a better parent
             if (checkGoal(node->position)) return true;
             
             std::vector<Node*> neighbors;
-            m_board.getNeighbors(node, neighbors, m_diagonals, m_cutCorners);
+            m_board.getNeighbors(node, neighbors, m_movement);
+            PATHFINDING_METRIC(metrics.neighborChecks += neighbors.size());
             
+            neighbors.erase(std::remove_if(neighbors.begin(), neighbors.end(), [](const Node* neighbor) { return neighbor->closed; }), neighbors.end());
+            
+            // Evaluate every neighbor at once
+            NeighborBatch batch;
             for (auto* neighbor : neighbors)
             {
-                if (neighbor->closed) continue;
+                batch.push(neighbor->position, m_board.getCost(neighbor->position));
+            }
+            
+            double h[NeighborBatch::Capacity], g[NeighborBatch::Capacity];
+            heuristics(batch, h);
+            batch.moveCosts(node->position, node->g, g);
+            
+            for (size_t i = 0; i < neighbors.size(); ++i)
+            {
+                auto* neighbor = neighbors[i];
                 
-                updateNode(neighbor, node);
+                updateNode(neighbor, node, h[i], g[i]);
                 
                 if (neighbor->opened) continue;
                 
                 openNode(neighbor, node);
-                
-                if (checkGoal(neighbor->position)) return true;
             }
             
             return false;
         }
         
     protected:
+        /**
+         * Create a board with the size, start, and goal position given, for algorithms derived from A*
+         *
+         * @param size Size of the board
+         * @param start Start position of the board
+         * @param goal Goal position of the board
+         * @param name Name of the algorithm
+         */
+        AStar(const Coordinate& size, const Coordinate& start, const Coordinate& goal, std::string &&name)
+        : m_board{size, start, goal}, AlgorithmBase(std::move(name)) {}
+        
+        /**
+         * Estimates the cost from the given coordinate to the goal
+         *
+         * @param c Coordinate from which the cost is estimated
+         * @return Estimated cost to the goal
+         */
+        virtual double heuristic(const Coordinate& c) const
+        {
+            return heuristicDistance(c, m_board.getGoal());
+        }
+        
+        /**
+         * Estimates the cost to the goal from every neighbor of the batch, at once
+         *
+         * @param batch Neighbors from which the cost is estimated
+         * @param h Output of the estimated costs, with room for the capacity of the batch
+         */
+        virtual void heuristics(const NeighborBatch& batch, double* h) const
+        {
+            batch.heuristics(m_board.getGoal(), m_heuristic, m_minCost, h);
+        }
+        
         void sortNodes(std::vector<Node*>& openNodes)
         {
             std::sort(openNodes.begin(), openNodes.end(), [](const Node* node1, const Node* node2)
@@ -157,15 +214,16 @@ namespace PathFinding
             AlgorithmBase::openNode(node, parent);
             
             m_openNodes.push_back(node);
+            PATHFINDING_METRIC(++metrics.pushes);
+            PATHFINDING_METRIC(metrics.updateOpenNodes(m_openNodes.size(), sizeof(Node*)));
         }
         
-        void updateNode(Node* neighbor, Node* parent)
+        void updateNode(Node* neighbor, Node* parent, const double h, const double g)
         {
-            auto h = distance(neighbor->position, m_board.getGoal());
-            auto g = parent->g + distance(parent->position, neighbor->position);
-
             if (h + g < neighbor->h + neighbor->g)
             {
+                PATHFINDING_METRIC(metrics.decreaseKeys += neighbor->opened);
+                if (neighbor->opened) markChanged(neighbor->position, Change::Parent);
                 neighbor->parent = parent;
                 neighbor->h = h;
                 neighbor->g = g;
@@ -175,9 +233,11 @@ namespace PathFinding
         Node* closeNode()
         {
             ++nodesClosed;
+            PATHFINDING_METRIC(++metrics.pops);
             
             auto* node = m_openNodes.back();
             m_openNodes.pop_back();
+            markChanged(node->position, Change::Closed);
             node->closed = true;
             
             return node;
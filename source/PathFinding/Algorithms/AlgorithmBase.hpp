@@ -2,9 +2,14 @@
 #define ALGORITHM_BASE_H
 #pragma once
 
+#include <algorithm>
 #include <cmath>
+#include <iterator>
+#include <string>
 #include <vector>
 #include "../Board.hpp"
+#include "../CompactPath.hpp"
+#include "../Metrics.hpp"
 
 
 namespace PathFinding
@@ -18,6 +23,37 @@ namespace PathFinding
         Chebyshev
     };
 
+    /**
+     * Checks if a heuristic never overestimates the cost to the goal, so A* only finds optimal solutions with it
+     *
+     * @param heuristic Heuristic to check
+     * @param diagonals The algorithm can use diagonal movements
+     * @return Whether the heuristic is admissible with the moves allowed
+     */
+    constexpr bool IsAdmissible(const Heuristic heuristic, const bool diagonals)
+    {
+        // Only the Diagonal (octile) distance prices a diagonal as the moves do, the rest overestimate it
+        return !diagonals || heuristic == Heuristic::Diagonal;
+    }
+
+    /// Kind of change of a node
+    enum class Change
+    {
+        Opened,
+        Closed,
+        Parent
+    };
+    
+    /// Change of a node during a step
+    struct NodeChange
+    {
+        /// Position of the node changed
+        Coordinate position;
+        
+        /// Kind of change
+        Change change;
+    };
+
     /// Base clase for PathFinding algorithms
     class AlgorithmBase
     {
@@ -29,14 +65,34 @@ namespace PathFinding
         /// Collection of solution coordinates
         std::vector<Coordinate> solution;
         
+        /// Solution from the start as directions, stored instead of the collection of coordinates if storeCompact is set
+        CompactPath compactSolution;
+        
+        /// Whether the solution is stored as directions or not
+        bool storeCompact = false;
+        
         /// Number of nodes opened
         unsigned long nodesOpened = 0;
         
         /// Number of nodes closed
         unsigned long nodesClosed = 0;
         
+        /// Whether the changes of the nodes are stored or not
+        bool trackChanges = false;
+        
+        /// Changes of the nodes since they were last consumed, only stored if trackChanges is set
+        std::vector<NodeChange> changes;
+        
+#ifdef PATHFINDING_METRICS
+        /// Counters of the last run
+        Metrics metrics;
+#endif
+        
     protected:
         
+        /// Cost of a diagonal move between neighbor nodes, before the traversal cost
+        static constexpr float m_diagonalCost = 1.414f;
+        
         /// Heuristic to calculate the distance between nodes
         Heuristic m_heuristic = Heuristic::Manhattan;
         
@@ -45,6 +101,12 @@ namespace PathFinding
         
         ///Whether you can cut obstacles corners or not
         bool m_cutCorners = true;
+        
+        /// Moves allowed by the diagonals and cutCorners flags, resolved once per search so the neighbor generators don't check them
+        Movement m_movement = Movement::Diagonal;
+        
+        /// Minimum traversal cost of the board when the algorithm was initiated, used to scale the heuristics
+        double m_minCost = 1.f;
 
     public:
         explicit AlgorithmBase(std::string &&name = {}) : name(std::move(name)) {}
@@ -63,10 +125,16 @@ namespace PathFinding
             m_heuristic = heuristic;
             m_diagonals = diagonals;
             m_cutCorners = cutCorners;
+            m_movement = GetMovement(diagonals, cutCorners);
+            m_minCost = getMinCost();
             
             nodesOpened = 0;
+            nodesClosed = 0;
+            PATHFINDING_METRIC(metrics.reset());
             
             solution.clear();
+            compactSolution.clear();
+            changes.clear();
         }
         
         /**
@@ -75,8 +143,12 @@ namespace PathFinding
         virtual void reset()
         {
             nodesOpened = 0;
+            nodesClosed = 0;
+            PATHFINDING_METRIC(metrics.reset());
             
             solution.clear();
+            compactSolution.clear();
+            changes.clear();
         }
         
         /**
@@ -122,13 +194,58 @@ namespace PathFinding
          */
         virtual inline const bool isObstacle(const Coordinate& c) const = 0;
         
+        /**
+         * Gets the state of the node at a given coordinate
+         *
+         * @param c Coordinate of the node
+         * @return The state of the node
+         */
+        virtual inline const NodeState getState(const Coordinate& c) const = 0;
+        
         /**
          * Sets the node at a given coordinate as an obstacle or not
          *
          * @param c Coordinate in which the obstacle field is modified
          * @param obstacle Wether we set it to be an obstacle or not
          */
-        virtual inline const void setObstacle(const Coordinate& c, const bool obstacle = true) const = 0;
+        virtual inline void setObstacle(const Coordinate& c, const bool obstacle = true) = 0;
+        
+        /**
+         * Sets every node of the board as an obstacle or not from a dense grid
+         *
+         * @param obstacles Grid with an entry per node
+         */
+        virtual inline void setObstacles(const ObstacleGrid& obstacles) = 0;
+        
+        /**
+         * Gets the traversal cost of the node at a given coordinate
+         *
+         * @param c Coordinate of the node
+         * @return The traversal cost of the node
+         */
+        virtual inline const Cost getCost(const Coordinate& c) const = 0;
+        
+        /**
+         * Sets the traversal cost of the node at a given coordinate
+         *
+         * @param c Coordinate in which the cost is modified
+         * @param cost Cost of moving into the node
+         */
+        virtual inline void setCost(const Coordinate& c, const Cost cost = 1) = 0;
+        
+        /**
+         * Sets the traversal cost of every node of the board
+         *
+         * @param costs Collection with the cost of every node
+         */
+        virtual inline void setCosts(const std::vector<Cost>& costs) = 0;
+        
+        /**
+         * Gets the minimum traversal cost of the board
+         *
+         * @return The minimum traversal cost of the board
+         */
+        virtual inline const Cost getMinCost() const = 0;
         
         //TODO: Remove
         virtual inline double getValue1(const Coordinate& c) const = 0;
@@ -141,7 +258,7 @@ namespace PathFinding
          *
          * @return Distance of the solution
          */
-        const double getSolutionDistance() const
+        virtual const double getSolutionDistance() const
         {
             double distance = 0.f;
             
@@ -149,12 +266,48 @@ namespace PathFinding
             {
                 for (int i = 0; i < solution.size() - 1; ++i)
                 {
-                    distance += isDiagonal(solution[i], solution[i + 1]) ? 1.414f : 1.f;
+                    // The solution is stored from the goal, so the move goes into the previous coordinate
+                    distance += moveCost(solution[i + 1], solution[i]);
+                }
+            }
+            else if (compactSolution.size())
+            {
+                for (auto previous = compactSolution.begin(), it = std::next(previous); it != compactSolution.end(); previous = it++)
+                {
+                    distance += moveCost(*previous, *it);
                 }
             }
             return distance;
         }
         
+        /**
+         * Checks if a solution has been found, stored as coordinates or as directions
+         *
+         * @return If a solution has been found
+         */
+        inline const bool hasSolution() const
+        {
+            return solution.size() || compactSolution.size();
+        }
+        
+        /**
+         * Stores the coordinates of the solution from the goal, as the collection of solution coordinates, also when the
+         * solution is stored as directions
+         *
+         * @param path Reference to the collection in which the coordinates are stored, cleared before
+         */
+        void getSolution(std::vector<Coordinate>& path) const
+        {
+            if (solution.size() || compactSolution.empty())
+            {
+                path = solution;
+                return;
+            }
+            
+            path.assign(compactSolution.begin(), compactSolution.end());
+            std::reverse(path.begin(), path.end());
+        }
+        
         /**
          * Runs the next step of the algorithm
          *
@@ -190,8 +343,10 @@ namespace PathFinding
         /**
          * Stores the solution if found
          */
-        void storeSolution()
+        virtual void storeSolution()
         {
+            if (storeCompact && storeCompactSolution()) return;
+            
             // Start on the goal and go back by parents
             auto* node = getGoalNode();
             
@@ -202,6 +357,30 @@ namespace PathFinding
             }
         }
         
+        /**
+         * Stores the solution as directions, counting its steps first so it is built without reallocations
+         *
+         * @return Whether every step is between neighbors, otherwise it can't be stored as directions
+         */
+        bool storeCompactSolution()
+        {
+            size_t steps = 0;
+            const auto* start = getGoalNode();
+            for (; start->parent; start = start->parent)
+            {
+                if (CompactPath::GetDirection(start->parent->position, start->position) < 0) return false;
+                ++steps;
+            }
+            
+            // Go back by parents from the goal, filling the steps from the last one
+            compactSolution.assign(start->position, steps);
+            for (const auto* node = getGoalNode(); node->parent; node = node->parent)
+            {
+                compactSolution.setStep(--steps, node->parent->position, node->position);
+            }
+            return true;
+        }
+        
         /**
          * Opens a node
          *
@@ -214,6 +393,22 @@ namespace PathFinding
             
             node->parent = parent;
             node->opened = true;
+            
+            markChanged(node->position, Change::Opened);
+        }
+        
+        /**
+         * Stores the change of a node, if the changes are tracked
+         *
+         * @param c Coordinate of the node changed
+         * @param change Kind of change
+         */
+        inline void markChanged(const Coordinate& c, const Change change)
+        {
+            if (trackChanges)
+            {
+                changes.push_back({c, change});
+            }
         }
         
         /**
@@ -228,6 +423,30 @@ namespace PathFinding
             return c1.first != c2.first && c1.second != c2.second;
         }
         
+        /**
+         * Calculates the cost of moving between two neighbor coordinates, taking into account the cost of the node moved into
+         *
+         * @param from Coordinate moved from
+         * @param to Coordinate moved into
+         * @return Cost of the move
+         */
+        const double moveCost(const Coordinate& from, const Coordinate& to) const
+        {
+            return (isDiagonal(from, to) ? m_diagonalCost : 1.f) * getCost(to);
+        }
+        
+        /**
+         * Calculates the heuristic distance between the two given coordinates, scaled by the minimum cost so it stays admissible
+         *
+         * @param from First coordinate
+         * @param to Second coordinate
+         * @return Heuristic distance between the two given coordinates
+         */
+        const double heuristicDistance(const Coordinate& from, const Coordinate& to) const
+        {
+            return distance(from, to) * m_minCost;
+        }
+        
         /**
          * Calculates the distance between the two given coordinates with the Heuristic given
          *
@@ -0,0 +1,102 @@
+#ifndef BEAM_SEARCH_H
+#define BEAM_SEARCH_H
+#pragma once
+
+#include <algorithm>
+#include "BestFirstSearch.hpp"
+
+
+namespace PathFinding
+{
+    /// Best First Search by layers, only the best nodes of every layer are evaluated, so the memory used is bounded
+    /// by the beam width whatever the size of the board. A solution may not be found even if there is one
+    class BeamSearch : public BestFirstSearch
+    {
+    private:
+        /// Best nodes opened from the current layer, a heap with the worst one on top so it is dropped in O(log width)
+        std::vector<Node*> m_nextLayer;
+
+    public:
+        /**
+         * Create a board with the size, start, and goal position given
+         *
+         * @param size Size of the board
+         * @param start Start position of the board
+         * @param goal Goal position of the board
+         * @param beamWidth Maximum number of nodes of every layer, at least 1
+         */
+        BeamSearch(const Coordinate& size, const Coordinate& start, const Coordinate& goal, const size_t beamWidth = 32)
+        : BestFirstSearch(size, start, goal, std::max<size_t>(beamWidth, 1), "Beam Search")
+        {
+            m_nextLayer.reserve(m_beamWidth + 1);
+        }
+        
+        virtual ~BeamSearch(){}
+        
+        void init(const Heuristic heuristic, const bool diagonals = true, const bool cutCorners = true) override
+        {
+            m_nextLayer.clear();
+            
+            BestFirstSearch::init(heuristic, diagonals, cutCorners);
+        }
+        
+        virtual void reset() override
+        {
+            m_nextLayer.clear();
+            
+            BestFirstSearch::reset();
+        }
+        
+        bool nextStep() override
+        {
+            // Start the next layer once the current one is evaluated
+            if (!m_openNodes.size())
+            {
+                if (!m_nextLayer.size()) return true;
+                
+                m_openNodes.swap(m_nextLayer);
+                sortNodes(m_openNodes);
+            }
+            
+            auto* node = closeNode();
+            
+            if (checkGoal(node->position)) return true;
+            
+            std::vector<Node*> neighbors;
+            m_board.getNeighbors(node, neighbors, m_movement);
+            PATHFINDING_METRIC(metrics.neighborChecks += neighbors.size());
+            
+            for (auto* neighbor : neighbors)
+            {
+                if (neighbor->opened) continue;
+                
+                openNextLayer(neighbor, node);
+                
+                if (checkGoal(neighbor->position)) return true;
+            }
+            
+            return false;
+        }
+        
+    private:
+        /**
+         * Opens a node into the next layer, dropping the worst node of the layer if it is full.
+         * Dropped nodes stay opened, so they are never evaluated
+         *
+         * @param node Node to open
+         * @param parent Node to set as parent of the node to open
+         */
+        void openNextLayer(Node* node, Node* parent)
+        {
+            AlgorithmBase::openNode(node, parent);
+            
+            node->h = distance(node->position, m_board.getGoal());
+            pushBounded(m_nextLayer, node);
+            PATHFINDING_METRIC(++metrics.pushes);
+            
+            PATHFINDING_METRIC(metrics.updateOpenNodes(m_openNodes.size() + m_nextLayer.size(), sizeof(Node*)));
+        }
+    };
+}
+
+#endif
@@ -2,6 +2,8 @@
 #define BEST_FIRST_SEARCH_H
 #pragma once
 
+#include <algorithm>
+#include <limits>
 #include "AlgorithmBase.hpp"
 
 
@@ -9,6 +11,7 @@ namespace PathFinding
 {
     class BestFirstSearch : public AlgorithmBase
     {
+    protected:
         struct Node : NodeBase
         {
             /// Heuristics calculations
@@ -27,12 +30,14 @@ namespace PathFinding
             }
         };
         
-    protected:
-        /// Collection of nodes yet to be evaluated.
+        /// Collection of nodes yet to be evaluated. With a beam width, a heap with the worst one on top so it is dropped in O(log width)
         std::vector<Node*> m_openNodes;
         
         /// Node's board
         Board<Node> m_board;
+        
+        /// Maximum number of nodes yet to be evaluated, the worst ones are dropped. Unbounded if 0
+        size_t m_beamWidth = 0;
 
     public:
         /**
@@ -41,9 +46,11 @@ namespace PathFinding
          * @param size Size of the board
          * @param start Start position of the board
          * @param goal Goal position of the board
+         * @param beamWidth Maximum number of nodes yet to be evaluated, the worst ones are dropped so the memory is bounded,
+         *                  but a solution may not be found. Unbounded if 0
          */
-        BestFirstSearch(const Coordinate& size, const Coordinate& start, const Coordinate& goal)
-        : m_board{size, start, goal}, AlgorithmBase("Best First Search") {}
+        BestFirstSearch(const Coordinate& size, const Coordinate& start, const Coordinate& goal, const size_t beamWidth = 0)
+        : BestFirstSearch(size, start, goal, beamWidth, "Best First Search") {}
         
         virtual ~BestFirstSearch(){}
         
@@ -61,6 +68,7 @@ namespace PathFinding
             m_openNodes.clear();
             
             m_board.init();
+            PATHFINDING_METRIC(metrics.boardMemory = m_board.getMemoryUsage());
             
             openNode(m_board.getStartNode());
         }
@@ -86,11 +94,23 @@ namespace PathFinding
         
         inline const bool isObstacle(const Coordinate& c) const override { return m_board.isObstacle(c); }
         
-        inline const void setObstacle(const Coordinate& c, const bool obstacle = true) const override
+        inline const NodeState getState(const Coordinate& c) const override { return m_board.getState(c); }
+        
+        inline void setObstacle(const Coordinate& c, const bool obstacle = true) override
         {
             m_board.setObstacle(c, obstacle);
         }
         
+        inline void setObstacles(const ObstacleGrid& obstacles) override { m_board.setObstacles(obstacles); }
+        
+        inline const Cost getCost(const Coordinate& c) const override { return m_board.getCost(c); }
+        
+        inline void setCost(const Coordinate& c, const Cost cost = 1) override { m_board.setCost(c, cost); }
+        
+        inline void setCosts(const std::vector<Cost>& costs) override { m_board.setCosts(costs); }
+        
+        inline const Cost getMinCost() const override { return m_board.getMinCost(); }
+        
         //TODO: Remove
         inline double getValue1(const Coordinate& c) const override
         {
@@ -107,14 +127,19 @@ namespace PathFinding
         {
             if (!m_openNodes.size()) return true;
             
-            sortNodes(m_openNodes);
+            // The bounded heap is kept as it is, the best node is taken out of it
+            if (m_beamWidth)
+                takeBestNode(m_openNodes);
+            else
+                sortNodes(m_openNodes);
             
             auto* node = closeNode();
             
             if (checkGoal(node->position)) return true;
             
             std::vector<Node*> neighbors;
-            m_board.getNeighbors(node, neighbors, m_diagonals, m_cutCorners);
+            m_board.getNeighbors(node, neighbors, m_movement);
+            PATHFINDING_METRIC(metrics.neighborChecks += neighbors.size());
             
             for (auto* neighbor : neighbors)
             {
@@ -129,12 +154,23 @@ namespace PathFinding
         }
 
     protected:
+        /**
+         * Create a board with the size, start, and goal position given, for algorithms derived from Best First Search
+         *
+         * @param size Size of the board
+         * @param start Start position of the board
+         * @param goal Goal position of the board
+         * @param beamWidth Maximum number of nodes yet to be evaluated, unbounded if 0
+         * @param name Name of the algorithm
+         */
+        BestFirstSearch(const Coordinate& size, const Coordinate& start, const Coordinate& goal, const size_t beamWidth, std::string &&name)
+        : AlgorithmBase(std::move(name)), m_board{size, start, goal}, m_beamWidth(beamWidth) {}
         
         void sortNodes(std::vector<Node*>& openNodes)
         {
             std::sort(openNodes.begin(), openNodes.end(), [](const Node* node1, const Node* node2)
             {
-                return node1->h >= node2->h;
+                return node1->h > node2->h;
             });
         }
         
@@ -143,15 +179,65 @@ namespace PathFinding
             AlgorithmBase::openNode(node, parent);
             
             node->h = distance(node->position, m_board.getGoal());
-            m_openNodes.push_back(node);
+            PATHFINDING_METRIC(++metrics.pushes);
+            
+            if (m_beamWidth)
+                pushBounded(m_openNodes, node);
+            else
+                m_openNodes.push_back(node);
+            
+            PATHFINDING_METRIC(metrics.updateOpenNodes(m_openNodes.size(), sizeof(Node*)));
+        }
+        
+        static bool isBetter(const Node* node1, const Node* node2)
+        {
+            return node1->h < node2->h;
+        }
+        
+        /**
+         * Pushes a node into a heap with the worst node on top, dropping the worst node if it has more nodes than the beam width.
+         * Dropped nodes stay opened, so they are never evaluated
+         *
+         * @param heap Heap of nodes, of the beam width at most
+         * @param node Node to push
+         */
+        void pushBounded(std::vector<Node*>& heap, Node* node)
+        {
+            heap.push_back(node);
+            std::push_heap(heap.begin(), heap.end(), isBetter);
+            
+            if (heap.size() > m_beamWidth)
+            {
+                std::pop_heap(heap.begin(), heap.end(), isBetter);
+                heap.pop_back();
+            }
+        }
+        
+        /**
+         * Moves the best node of a heap with the worst node on top to its back, keeping the rest a heap. The best node is
+         * one of the leaves, so only they are searched, and the node moved into its place has no children to sift down to
+         *
+         * @param heap Heap of nodes, not empty
+         */
+        static void takeBestNode(std::vector<Node*>& heap)
+        {
+            const auto leaves = heap.begin() + heap.size() / 2;
+            const auto best = std::min_element(leaves, heap.end(), isBetter);
+            
+            std::iter_swap(best, heap.end() - 1);
+            if (best != heap.end() - 1)
+                std::push_heap(heap.begin(), best + 1, isBetter);
         }
         
         Node* closeNode()
         {
             ++nodesClosed;
+            PATHFINDING_METRIC(++metrics.pops);
             
             auto* node = m_openNodes.back();
             m_openNodes.pop_back();
+            markChanged(node->position, Change::Closed);
+            node->closed = true;
             
             return node;
         }
@@ -0,0 +1,295 @@
+#ifndef CHUNKED_A_STAR_H
+#define CHUNKED_A_STAR_H
+#pragma once
+
+#include <algorithm>
+#include <limits>
+#include "AlgorithmBase.hpp"
+#include "../ChunkedBoard.hpp"
+
+
+namespace PathFinding
+{
+    /// A* on a board split in chunks allocated on first touch, for worlds too big to allocate whole, like a map of
+    /// 100000x100000 nodes, of which the search only explores a small part. The memory used is proportional to the
+    /// explored area, plus a few bytes per chunk of the board. The open list is a binary heap of coordinates, and the goal
+    /// is checked when it is expanded
+    class ChunkedAStar : public AlgorithmBase
+    {
+        struct Node : ChunkedNode
+        {
+            /// Cost from the start
+            double g = std::numeric_limits<double>::max();
+        };
+
+        /// Node waiting to be evaluated, it is stale if the node got a better cost after it was pushed
+        struct Entry
+        {
+            double f;
+            double g;
+            Coordinate position;
+        };
+
+        /// Collection of nodes yet to be evaluated, a heap with the lowest cost on top
+        std::vector<Entry> m_openNodes;
+
+        /// Node's board
+        ChunkedBoard<Node> m_board;
+
+        /// Whether the search has finished
+        bool m_finished = false;
+
+    public:
+        /// Whether the chunks of nodes are released as soon as the search finishes, after storing the solution. Otherwise
+        /// they are kept until the next search, so the states of the nodes can be shown
+        bool releaseNodes = true;
+
+        /**
+         * Create a board with the size, start, and goal position given
+         *
+         * @param size Size of the board
+         * @param start Start position of the board
+         * @param goal Goal position of the board
+         */
+        ChunkedAStar(const Coordinate& size, const Coordinate& start, const Coordinate& goal)
+        : AlgorithmBase("Chunked A*"), m_board{size, start, goal} {}
+
+        virtual ~ChunkedAStar(){}
+
+        void init(const Heuristic heuristic, const bool diagonals = true, const bool cutCorners = true) override
+        {
+            AlgorithmBase::init(heuristic, diagonals, cutCorners);
+
+            m_openNodes.clear();
+            m_finished = false;
+
+            m_board.init();
+            PATHFINDING_METRIC(metrics.boardMemory = m_board.getMemoryUsage());
+
+            if (m_board.isValidNode(m_board.getStart()))
+                openNode(m_board.getStart(), ChunkedNode::None, 0.f);
+        }
+
+        virtual void reset() override
+        {
+            AlgorithmBase::reset();
+
+            m_openNodes.clear();
+            m_finished = false;
+
+            m_board.reset();
+        }
+
+        inline const size_t getTotalSize() const override { return m_board.getTotalSize(); }
+
+        inline const Coordinate getSize() const override { return m_board.getSize(); }
+
+        inline const Coordinate getStart() const override { return m_board.getStart(); }
+
+        inline const Coordinate getGoal() const override { return m_board.getGoal(); }
+
+        /// The nodes are not derived from NodeBase, the solution is stored from the directions of the parents
+        inline const NodeBase* getGoalNode() const override { return nullptr; }
+
+        inline const bool isObstacle(const Coordinate& c) const override { return m_board.isObstacle(c); }
+
+        inline const NodeState getState(const Coordinate& c) const override { return m_board.getState(c); }
+
+        inline void setObstacle(const Coordinate& c, const bool obstacle = true) override
+        {
+            m_board.setObstacle(c, obstacle);
+        }
+
+        inline void setObstacles(const ObstacleGrid& obstacles) override { m_board.setObstacles(obstacles); }
+
+        inline const Cost getCost(const Coordinate& c) const override { return m_board.getCost(c); }
+
+        inline void setCost(const Coordinate& c, const Cost cost = 1) override { m_board.setCost(c, cost); }
+
+        inline void setCosts(const std::vector<Cost>& costs) override { m_board.setCosts(costs); }
+
+        inline const Cost getMinCost() const override { return m_board.getMinCost(); }
+
+        /**
+         * Returns the number of chunks of nodes allocated by the search, 0 once they are released
+         *
+         * @return Number of chunks of nodes allocated
+         */
+        inline size_t getNodeChunks() const { return m_board.getNodeChunks(); }
+
+        //TODO: Remove
+        inline double getValue1(const Coordinate& c) const override
+        {
+            const auto* node = m_board.isValidNode(c) ? m_board.find(c) : nullptr;
+            return node && node->is(ChunkedNode::Opened) ? heuristicDistance(c, m_board.getGoal()) : 0.f;
+        }
+
+        //TODO: Remove
+        inline double getValue2(const Coordinate& c) const override
+        {
+            const auto* node = m_board.isValidNode(c) ? m_board.find(c) : nullptr;
+            return node && node->is(ChunkedNode::Opened) ? node->g : 0.f;
+        }
+
+        bool nextStep() override
+        {
+            if (m_finished) return true;
+
+            // Drop the entries of the nodes improved after they were pushed
+            while (m_openNodes.size() && m_openNodes.front().g > m_board[m_openNodes.front().position].g)
+            {
+                popEntry();
+            }
+
+            if (m_openNodes.empty()) return finish();
+
+            const auto position = popEntry().position;
+            auto& node = m_board[position];
+
+            node.set(ChunkedNode::Closed);
+            ++nodesClosed;
+            markChanged(position, Change::Closed);
+
+            if (position == m_board.getGoal())
+            {
+                storeSolution();
+                return finish();
+            }
+
+            m_neighbors.clear();
+            m_board.getNeighbors(position, m_neighbors, m_movement);
+            PATHFINDING_METRIC(metrics.neighborChecks += m_neighbors.size());
+
+            for (const auto& neighbor : m_neighbors)
+            {
+                const auto& next = m_board[neighbor];
+                if (next.is(ChunkedNode::Closed)) continue;
+
+                const auto g = node.g + moveCost(position, neighbor);
+                if (g >= next.g) continue;
+
+                PATHFINDING_METRIC(metrics.decreaseKeys += next.is(ChunkedNode::Opened));
+                openNode(neighbor, GetDirection(neighbor, position), g);
+            }
+
+            return false;
+        }
+
+    protected:
+        void storeSolution() override
+        {
+            const auto& directions = ChunkedBoard<Node>::Directions;
+            const auto goal = m_board.getGoal();
+
+            if (storeCompact)
+            {
+                // Count the steps first, so the path is built without reallocations
+                size_t steps = 0;
+                auto start = goal;
+                for (std::uint8_t parent; (parent = m_board[start].parent) != ChunkedNode::None; ++steps)
+                {
+                    start = { start.first + directions[parent].first, start.second + directions[parent].second };
+                }
+
+                compactSolution.assign(start, steps);
+                for (auto c = goal; m_board[c].parent != ChunkedNode::None; )
+                {
+                    const auto parent = m_board[c].parent;
+                    const Coordinate previous{ c.first + directions[parent].first, c.second + directions[parent].second };
+                    compactSolution.setStep(--steps, previous, c);
+                    c = previous;
+                }
+                return;
+            }
+
+            // Start on the goal and go back by parents
+            for (auto c = goal; ; )
+            {
+                solution.push_back(c);
+
+                const auto parent = m_board[c].parent;
+                if (parent == ChunkedNode::None) break;
+                c = { c.first + directions[parent].first, c.second + directions[parent].second };
+            }
+        }
+
+    private:
+        /// Neighbors of the node expanded, kept to reuse its memory
+        std::vector<Coordinate> m_neighbors;
+
+        static bool isWorse(const Entry& entry1, const Entry& entry2)
+        {
+            return entry1.f == entry2.f ? entry1.g < entry2.g : entry1.f > entry2.f;
+        }
+
+        /**
+         * Returns the direction from a coordinate to one of its neighbors
+         *
+         * @param from Coordinate of the node
+         * @param to Coordinate of the neighbor
+         * @return Index of the direction, in the same order as the neighbors of the board
+         */
+        static std::uint8_t GetDirection(const Coordinate& from, const Coordinate& to)
+        {
+            const auto& directions = ChunkedBoard<Node>::Directions;
+            const Coordinate offset{ to.first - from.first, to.second - from.second };
+            return (std::uint8_t)(std::find(directions.begin(), directions.end(), offset) - directions.begin());
+        }
+
+        /**
+         * Marks the search as finished, releasing the chunks of nodes if releaseNodes is set
+         *
+         * @return Always true, so it can be returned by nextStep
+         */
+        bool finish()
+        {
+            m_finished = true;
+            PATHFINDING_METRIC(metrics.boardMemory = m_board.getMemoryUsage());
+
+            if (releaseNodes) m_board.release();
+            return true;
+        }
+
+        /**
+         * Opens or improves a node, pushing a new entry for it
+         *
+         * @param position Coordinate of the node
+         * @param parent Direction of the parent of the node
+         * @param g Cost from the start through the parent
+         */
+        void openNode(const Coordinate& position, const std::uint8_t parent, const double g)
+        {
+            auto& node = m_board[position];
+
+            if (!node.is(ChunkedNode::Opened))
+            {
+                ++nodesOpened;
+                markChanged(position, Change::Opened);
+            }
+            else
+            {
+                markChanged(position, Change::Parent);
+            }
+
+            node.set(ChunkedNode::Opened);
+            node.parent = parent;
+            node.g = g;
+
+            m_openNodes.push_back({ g + heuristicDistance(position, m_board.getGoal()), g, position });
+            std::push_heap(m_openNodes.begin(), m_openNodes.end(), isWorse);
+            PATHFINDING_METRIC(++metrics.pushes);
+            PATHFINDING_METRIC(metrics.updateOpenNodes(m_openNodes.size(), sizeof(Entry)));
+        }
+
+        Entry popEntry()
+        {
+            std::pop_heap(m_openNodes.begin(), m_openNodes.end(), isWorse);
+            const auto entry = m_openNodes.back();
+            m_openNodes.pop_back();
+            PATHFINDING_METRIC(++metrics.pops);
+            return entry;
+        }
+    };
+}
+
+#endif
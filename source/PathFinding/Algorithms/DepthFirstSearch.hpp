@@ -49,6 +49,7 @@ namespace PathFinding
             }
             
             m_board.init();
+            PATHFINDING_METRIC(metrics.boardMemory = m_board.getMemoryUsage());
             
             openNode(m_board.getStartNode());
         }
@@ -77,11 +78,23 @@ namespace PathFinding
         
         inline const bool isObstacle(const Coordinate& c) const override { return m_board.isObstacle(c); }
         
-        inline const void setObstacle(const Coordinate& c, const bool obstacle = true) const override
+        inline const NodeState getState(const Coordinate& c) const override { return m_board.getState(c); }
+        
+        inline void setObstacle(const Coordinate& c, const bool obstacle = true) override
         {
             m_board.setObstacle(c, obstacle);
         }
         
+        inline void setObstacles(const ObstacleGrid& obstacles) override { m_board.setObstacles(obstacles); }
+        
+        inline const Cost getCost(const Coordinate& c) const override { return m_board.getCost(c); }
+        
+        inline void setCost(const Coordinate& c, const Cost cost = 1) override { m_board.setCost(c, cost); }
+        
+        inline void setCosts(const std::vector<Cost>& costs) override { m_board.setCosts(costs); }
+        
+        inline const Cost getMinCost() const override { return m_board.getMinCost(); }
+        
         //TODO: Remove
         inline double getValue1(const Coordinate& c) const override
         {
@@ -103,7 +116,8 @@ namespace PathFinding
             if (checkGoal(node->position)) return true;
             
             std::vector<Node*> neighbors;
-            m_board.getNeighbors(node, neighbors, m_diagonals, m_cutCorners);
+            m_board.getNeighbors(node, neighbors, m_movement);
+            PATHFINDING_METRIC(metrics.neighborChecks += neighbors.size());
             
             bool changes = false;
             for (auto* neighbor : neighbors)
@@ -131,12 +145,17 @@ namespace PathFinding
             AlgorithmBase::openNode(node, parent);
             
             m_openNodes.push(node);
+            PATHFINDING_METRIC(++metrics.pushes);
+            PATHFINDING_METRIC(metrics.updateOpenNodes(m_openNodes.size(), sizeof(Node*)));
         }
         
         void closeNode()
         {
             ++nodesClosed;
+            PATHFINDING_METRIC(++metrics.pops);
             
+            markChanged(m_openNodes.top()->position, Change::Closed);
+            m_openNodes.top()->closed = true;
             m_openNodes.pop();
         }
     };
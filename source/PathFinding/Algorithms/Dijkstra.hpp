@@ -0,0 +1,39 @@
+#ifndef DIJKSTRA_H
+#define DIJKSTRA_H
+#pragma once
+
+#include "AStar.hpp"
+
+
+namespace PathFinding
+{
+    /// A* without heuristic, so nodes are evaluated only by their accumulated cost
+    class Dijkstra : public AStar
+    {
+    public:
+        /**
+         * Create a board with the size, start, and goal position given
+         *
+         * @param size Size of the board
+         * @param start Start position of the board
+         * @param goal Goal position of the board
+         */
+        Dijkstra(const Coordinate& size, const Coordinate& start, const Coordinate& goal)
+        : AStar(size, start, goal, "Dijkstra") {}
+        
+        virtual ~Dijkstra(){}
+        
+    protected:
+        double heuristic(const Coordinate&) const override
+        {
+            return 0.f;
+        }
+        
+        void heuristics(const NeighborBatch& batch, double* h) const override
+        {
+            std::fill(h, h + batch.size(), 0.f);
+        }
+    };
+}
+
+#endif
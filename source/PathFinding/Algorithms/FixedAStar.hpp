@@ -0,0 +1,286 @@
+#ifndef FIXED_A_STAR_H
+#define FIXED_A_STAR_H
+#pragma once
+
+#include <limits>
+#include "AlgorithmBase.hpp"
+#include "../FixedBoard.hpp"
+
+
+namespace PathFinding
+{
+    /// A* on a board with its size known at compile time, for tiny boards searched millions of times. The board and the
+    /// open list, a binary heap of node indexes with one slot per node, are arrays inside of the algorithm, so the search
+    /// doesn't allocate. Only the solution does, the first time it grows. The goal is checked when it is expanded
+    template <int Width, int Height>
+    class FixedAStar : public AlgorithmBase
+    {
+        struct Node : SlimNode
+        {
+            /// Cost from the start
+            double g = std::numeric_limits<double>::max();
+
+            /// Cost from the start plus the heuristic distance to the goal
+            double f = std::numeric_limits<double>::max();
+
+            /// Position of the node on the open list, while it is opened and not closed
+            std::uint32_t heapIndex = 0;
+        };
+
+        typedef FixedBoard<Node, Width, Height> NodeBoard;
+
+        /// Node's board
+        NodeBoard m_board;
+
+        /// Collection of nodes yet to be evaluated, a heap of indexes with the lowest cost on top
+        std::array<std::uint32_t, NodeBoard::TotalSize> m_openNodes;
+
+        /// Number of nodes of the open list
+        std::uint32_t m_openCount = 0;
+
+        /// Whether the goal has been expanded
+        bool m_found = false;
+
+    public:
+        /**
+         * Create a board with the start and goal position given, the size is the one of the type
+         *
+         * @param start Start position of the board
+         * @param goal Goal position of the board
+         */
+        FixedAStar(const Coordinate& start, const Coordinate& goal)
+        : AlgorithmBase("Fixed A*"), m_board{start, goal} {}
+
+        virtual ~FixedAStar(){}
+
+        void init(const Heuristic heuristic, const bool diagonals = true, const bool cutCorners = true) override
+        {
+            AlgorithmBase::init(heuristic, diagonals, cutCorners);
+
+            m_openCount = 0;
+            m_found = false;
+
+            m_board.init();
+            PATHFINDING_METRIC(metrics.boardMemory = m_board.getMemoryUsage());
+
+            if (NodeBoard::IsValidNode(m_board.getStart()))
+                openNode(NodeBoard::GetIndex(m_board.getStart()), SlimNode::None, 0.f);
+        }
+
+        virtual void reset() override
+        {
+            AlgorithmBase::reset();
+
+            m_openCount = 0;
+            m_found = false;
+
+            m_board.reset();
+        }
+
+        inline const size_t getTotalSize() const override { return m_board.getTotalSize(); }
+
+        inline const Coordinate getSize() const override { return m_board.getSize(); }
+
+        inline const Coordinate getStart() const override { return m_board.getStart(); }
+
+        inline const Coordinate getGoal() const override { return m_board.getGoal(); }
+
+        /// The nodes are not derived from NodeBase, the solution is stored from the indexes of the parents
+        inline const NodeBase* getGoalNode() const override { return nullptr; }
+
+        inline const bool isObstacle(const Coordinate& c) const override { return m_board.isObstacle(c); }
+
+        inline const NodeState getState(const Coordinate& c) const override { return m_board.getState(c); }
+
+        inline void setObstacle(const Coordinate& c, const bool obstacle = true) override
+        {
+            m_board.setObstacle(c, obstacle);
+        }
+
+        inline void setObstacles(const ObstacleGrid& obstacles) override { m_board.setObstacles(obstacles); }
+
+        inline const Cost getCost(const Coordinate& c) const override { return m_board.getCost(c); }
+
+        inline void setCost(const Coordinate& c, const Cost cost = 1) override { m_board.setCost(c, cost); }
+
+        inline void setCosts(const std::vector<Cost>& costs) override { m_board.setCosts(costs); }
+
+        inline const Cost getMinCost() const override { return m_board.getMinCost(); }
+
+        //TODO: Remove
+        inline double getValue1(const Coordinate& c) const override
+        {
+            return NodeBoard::IsValidNode(c) && m_board[NodeBoard::GetIndex(c)].is(SlimNode::Opened) ? heuristicDistance(c, m_board.getGoal()) : 0.f;
+        }
+
+        //TODO: Remove
+        inline double getValue2(const Coordinate& c) const override
+        {
+            return NodeBoard::IsValidNode(c) && m_board[NodeBoard::GetIndex(c)].is(SlimNode::Opened) ? m_board[NodeBoard::GetIndex(c)].g : 0.f;
+        }
+
+        bool nextStep() override
+        {
+            if (m_found || !m_openCount) return true;
+
+            const auto index = popNode();
+            auto& node = m_board[index];
+            const auto position = NodeBoard::GetPosition(index);
+
+            node.set(SlimNode::Closed);
+            ++nodesClosed;
+            markChanged(position, Change::Closed);
+
+            if (position == m_board.getGoal())
+            {
+                m_found = true;
+                storeSolution();
+                return true;
+            }
+
+            std::array<std::uint32_t, 8> neighbors;
+            const auto count = m_board.getNeighbors(index, neighbors, m_movement);
+            PATHFINDING_METRIC(metrics.neighborChecks += count);
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                const auto& next = m_board[neighbors[i]];
+                if (next.is(SlimNode::Closed)) continue;
+
+                const auto g = node.g + moveCost(position, NodeBoard::GetPosition(neighbors[i]));
+                if (g >= next.g) continue;
+
+                PATHFINDING_METRIC(metrics.decreaseKeys += next.is(SlimNode::Opened));
+                openNode(neighbors[i], index, g);
+            }
+
+            return false;
+        }
+
+    protected:
+        void storeSolution() override
+        {
+            const auto goal = NodeBoard::GetIndex(m_board.getGoal());
+
+            if (storeCompact)
+            {
+                // Count the steps first, so the path is built without reallocations
+                size_t steps = 0;
+                auto start = goal;
+                for (; m_board[start].parent != SlimNode::None; start = m_board[start].parent) ++steps;
+
+                compactSolution.assign(NodeBoard::GetPosition(start), steps);
+                for (auto index = goal; m_board[index].parent != SlimNode::None; index = m_board[index].parent)
+                {
+                    compactSolution.setStep(--steps, NodeBoard::GetPosition(m_board[index].parent), NodeBoard::GetPosition(index));
+                }
+                return;
+            }
+
+            // Start on the goal and go back by parents
+            for (auto index = goal; index != SlimNode::None; index = m_board[index].parent)
+            {
+                solution.push_back(NodeBoard::GetPosition(index));
+            }
+        }
+
+    private:
+        inline bool isWorse(const std::uint32_t index1, const std::uint32_t index2) const
+        {
+            const auto& node1 = m_board[index1];
+            const auto& node2 = m_board[index2];
+            return node1.f == node2.f ? node1.g < node2.g : node1.f > node2.f;
+        }
+
+        /**
+         * Opens or improves a node, adding it to the open list or moving it up if it was already on it
+         *
+         * @param index Index of the node
+         * @param parent Index of the parent of the node
+         * @param g Cost from the start through the parent
+         */
+        void openNode(const std::uint32_t index, const std::uint32_t parent, const double g)
+        {
+            auto& node = m_board[index];
+            const auto position = NodeBoard::GetPosition(index);
+
+            node.parent = parent;
+            node.g = g;
+            node.f = g + heuristicDistance(position, m_board.getGoal());
+
+            if (!node.is(SlimNode::Opened))
+            {
+                ++nodesOpened;
+                markChanged(position, Change::Opened);
+
+                node.set(SlimNode::Opened);
+                node.heapIndex = m_openCount++;
+                m_openNodes[node.heapIndex] = index;
+                PATHFINDING_METRIC(++metrics.pushes);
+                PATHFINDING_METRIC(metrics.updateOpenNodes(m_openCount, sizeof(std::uint32_t)));
+            }
+            else
+            {
+                markChanged(position, Change::Parent);
+            }
+
+            siftUp(node.heapIndex);
+        }
+
+        /**
+         * Removes the best node of the open list
+         *
+         * @return Index of the node removed
+         */
+        std::uint32_t popNode()
+        {
+            const auto index = m_openNodes[0];
+            PATHFINDING_METRIC(++metrics.pops);
+
+            if (--m_openCount)
+            {
+                place(0, m_openNodes[m_openCount]);
+                siftDown(0);
+            }
+            return index;
+        }
+
+        inline void place(const std::uint32_t heapIndex, const std::uint32_t index)
+        {
+            m_openNodes[heapIndex] = index;
+            m_board[index].heapIndex = heapIndex;
+        }
+
+        void siftUp(std::uint32_t heapIndex)
+        {
+            const auto index = m_openNodes[heapIndex];
+            while (heapIndex)
+            {
+                const auto parent = (heapIndex - 1) / 2;
+                if (!isWorse(m_openNodes[parent], index)) break;
+
+                place(heapIndex, m_openNodes[parent]);
+                heapIndex = parent;
+            }
+            place(heapIndex, index);
+        }
+
+        void siftDown(std::uint32_t heapIndex)
+        {
+            const auto index = m_openNodes[heapIndex];
+            while (true)
+            {
+                auto child = 2 * heapIndex + 1;
+                if (child >= m_openCount) break;
+                if (child + 1 < m_openCount && isWorse(m_openNodes[child], m_openNodes[child + 1])) ++child;
+                if (!isWorse(index, m_openNodes[child])) break;
+
+                place(heapIndex, m_openNodes[child]);
+                heapIndex = child;
+            }
+            place(heapIndex, index);
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,79 @@
+#ifndef LAZY_THETA_STAR_H
+#define LAZY_THETA_STAR_H
+#pragma once
+
+#include <limits>
+#include "ThetaStar.hpp"
+
+
+namespace PathFinding
+{
+    /// Theta* that assumes line of sight when a node is updated, and only checks it once the node is expanded,
+    /// so the line is checked once per node expanded instead of once per neighbor
+    class LazyThetaStar : public ThetaStar
+    {
+    public:
+        /**
+         * Create a board with the size, start, and goal position given
+         *
+         * @param size Size of the board
+         * @param start Start position of the board
+         * @param goal Goal position of the board
+         */
+        LazyThetaStar(const Coordinate& size, const Coordinate& start, const Coordinate& goal)
+        : ThetaStar(size, start, goal, "Lazy Theta*") {}
+        
+        virtual ~LazyThetaStar(){}
+        
+    protected:
+        /**
+         * Checks the line of sight with the parent assumed, and if there is none, takes the best expanded neighbor as parent
+         *
+         * @param node Node to be expanded
+         */
+        void setVertex(Node* node) override
+        {
+            auto* parent = static_cast<Node*>(node->parent);
+            if (!parent) return;
+            
+            const auto cost = m_board.getLineCost(parent->position, node->position, m_cutCorners);
+            double best = cost ? parent->g + lineCost(parent->position, node->position, cost) : std::numeric_limits<double>::max();
+            Node* bestParent = parent;
+            
+            std::vector<Node*> neighbors;
+            m_board.getNeighbors(node, neighbors, m_movement);
+            
+            for (auto* neighbor : neighbors)
+            {
+                if (!neighbor->closed) continue;
+                
+                const auto g = neighbor->g + moveCost(neighbor->position, node->position);
+                if (g < best)
+                {
+                    best = g;
+                    bestParent = neighbor;
+                }
+            }
+            
+            if (bestParent != parent) markChanged(node->position, Change::Parent);
+            node->parent = bestParent;
+            node->g = best;
+        }
+        
+        /**
+         * Updates a neighbor of the node expanded with the parent of the node, assuming there is line of sight between them
+         *
+         * @param node Node expanded
+         * @param neighbor Neighbor of the node, not closed
+         */
+        void updateVertex(Node* node, Node* neighbor) override
+        {
+            auto* parent = node->parent ? static_cast<Node*>(node->parent) : node;
+            
+            // The cost of the line is not known until it is checked, so the cost of the neighbor is taken as its lower bound
+            setParent(neighbor, parent, parent->g + lineCost(parent->position, neighbor->position, m_board.getCost(neighbor->position)));
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,226 @@
+#ifndef NEIGHBOR_BATCH_H
+#define NEIGHBOR_BATCH_H
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include "AlgorithmBase.hpp"
+
+#if !defined(PATHFINDING_NO_SIMD) && defined(__AVX2__)
+#define PATHFINDING_SIMD_AVX2
+#include <immintrin.h>
+#elif !defined(PATHFINDING_NO_SIMD) && defined(__SSE4_1__)
+#define PATHFINDING_SIMD_SSE
+#include <smmintrin.h>
+#endif
+
+
+namespace PathFinding
+{
+    /// Neighbors of a node stored by axis, so the heuristic and the cost of moving into every one of them are evaluated at
+    /// once. It uses AVX2 or SSE4.1 when the compiler targets them and PATHFINDING_NO_SIMD is not defined, and scalar code
+    /// otherwise, all of them with the same results as the distances of AlgorithmBase
+    class NeighborBatch
+    {
+    public:
+        /// Maximum number of neighbors of a node
+        static const size_t Capacity = 8;
+
+    private:
+        /// Coordinates of the neighbors by axis, the lanes after the size are evaluated but never read
+        alignas(32) std::int32_t m_x[Capacity]{};
+        alignas(32) std::int32_t m_y[Capacity]{};
+
+        /// Traversal cost of every neighbor
+        alignas(32) float m_costs[Capacity]{};
+
+        /// Number of neighbors stored
+        size_t m_size = 0;
+
+        /// Weight of a diagonal move
+        static constexpr float m_diagonal = 1.414f;
+
+    public:
+        inline void clear() { m_size = 0; }
+
+        inline const size_t size() const { return m_size; }
+
+        /**
+         * Adds a neighbor to the batch, up to the capacity
+         *
+         * @param c Coordinate of the neighbor
+         * @param cost Traversal cost of the neighbor
+         */
+        inline void push(const Coordinate& c, const Cost cost)
+        {
+            m_x[m_size] = c.first;
+            m_y[m_size] = c.second;
+            m_costs[m_size] = cost;
+            ++m_size;
+        }
+
+        /**
+         * Calculates the heuristic distance from every neighbor to the goal
+         *
+         * @param goal Coordinate of the goal
+         * @param heuristic Heuristic to use when calculating distances
+         * @param scale Factor applied to every distance, the minimum cost of the board
+         * @param h Output of the distances, with room for the capacity of the batch
+         */
+        void heuristics(const Coordinate& goal, const Heuristic heuristic, const double scale, double* h) const
+        {
+#if defined(PATHFINDING_SIMD_AVX2)
+            const auto dx = _mm256_abs_epi32(_mm256_sub_epi32(_mm256_load_si256((const __m256i*)m_x), _mm256_set1_epi32(goal.first)));
+            const auto dy = _mm256_abs_epi32(_mm256_sub_epi32(_mm256_load_si256((const __m256i*)m_y), _mm256_set1_epi32(goal.second)));
+            const auto factor = _mm256_set1_pd(scale);
+
+            switch (heuristic)
+            {
+                case Heuristic::Diagonal:
+                {
+                    // Calculated on floats, as the scalar distance
+                    const auto sum = _mm256_cvtepi32_ps(_mm256_add_epi32(dx, dy));
+                    const auto min = _mm256_cvtepi32_ps(_mm256_min_epi32(dx, dy));
+                    const auto distance = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_set1_ps(m_diagonal - 2), min));
+
+                    _mm256_storeu_pd(h, _mm256_mul_pd(_mm256_cvtps_pd(_mm256_castps256_ps128(distance)), factor));
+                    _mm256_storeu_pd(h + 4, _mm256_mul_pd(_mm256_cvtps_pd(_mm256_extractf128_ps(distance, 1)), factor));
+                    break;
+                }
+
+                case Heuristic::Euclidean:
+                {
+                    for (int half = 0; half < 2; ++half)
+                    {
+                        const auto x = _mm256_cvtepi32_pd(half ? _mm256_extracti128_si256(dx, 1) : _mm256_castsi256_si128(dx));
+                        const auto y = _mm256_cvtepi32_pd(half ? _mm256_extracti128_si256(dy, 1) : _mm256_castsi256_si128(dy));
+                        const auto distance = _mm256_sqrt_pd(_mm256_add_pd(_mm256_mul_pd(x, x), _mm256_mul_pd(y, y)));
+
+                        _mm256_storeu_pd(h + half * 4, _mm256_mul_pd(distance, factor));
+                    }
+                    break;
+                }
+
+                default:
+                {
+                    const auto distance = _mm256_add_epi32(dx, dy);
+
+                    _mm256_storeu_pd(h, _mm256_mul_pd(_mm256_cvtepi32_pd(_mm256_castsi256_si128(distance)), factor));
+                    _mm256_storeu_pd(h + 4, _mm256_mul_pd(_mm256_cvtepi32_pd(_mm256_extracti128_si256(distance, 1)), factor));
+                    break;
+                }
+            }
+#elif defined(PATHFINDING_SIMD_SSE)
+            const auto factor = _mm_set1_pd(scale);
+
+            for (size_t i = 0; i < Capacity; i += 4)
+            {
+                const auto dx = _mm_abs_epi32(_mm_sub_epi32(_mm_load_si128((const __m128i*)(m_x + i)), _mm_set1_epi32(goal.first)));
+                const auto dy = _mm_abs_epi32(_mm_sub_epi32(_mm_load_si128((const __m128i*)(m_y + i)), _mm_set1_epi32(goal.second)));
+
+                switch (heuristic)
+                {
+                    case Heuristic::Diagonal:
+                    {
+                        // Calculated on floats, as the scalar distance
+                        const auto sum = _mm_cvtepi32_ps(_mm_add_epi32(dx, dy));
+                        const auto min = _mm_cvtepi32_ps(_mm_min_epi32(dx, dy));
+                        const auto distance = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(m_diagonal - 2), min));
+
+                        _mm_storeu_pd(h + i, _mm_mul_pd(_mm_cvtps_pd(distance), factor));
+                        _mm_storeu_pd(h + i + 2, _mm_mul_pd(_mm_cvtps_pd(_mm_movehl_ps(distance, distance)), factor));
+                        break;
+                    }
+
+                    case Heuristic::Euclidean:
+                    {
+                        for (int half = 0; half < 2; ++half)
+                        {
+                            const auto x = _mm_cvtepi32_pd(half ? _mm_shuffle_epi32(dx, 0xee) : dx);
+                            const auto y = _mm_cvtepi32_pd(half ? _mm_shuffle_epi32(dy, 0xee) : dy);
+                            const auto distance = _mm_sqrt_pd(_mm_add_pd(_mm_mul_pd(x, x), _mm_mul_pd(y, y)));
+
+                            _mm_storeu_pd(h + i + half * 2, _mm_mul_pd(distance, factor));
+                        }
+                        break;
+                    }
+
+                    default:
+                    {
+                        const auto distance = _mm_add_epi32(dx, dy);
+
+                        _mm_storeu_pd(h + i, _mm_mul_pd(_mm_cvtepi32_pd(distance), factor));
+                        _mm_storeu_pd(h + i + 2, _mm_mul_pd(_mm_cvtepi32_pd(_mm_shuffle_epi32(distance, 0xee)), factor));
+                        break;
+                    }
+                }
+            }
+#else
+            for (size_t i = 0; i < m_size; ++i)
+            {
+                const auto dx = std::abs(m_x[i] - goal.first);
+                const auto dy = std::abs(m_y[i] - goal.second);
+
+                switch (heuristic)
+                {
+                    case Heuristic::Diagonal:
+                        h[i] = ((dx + dy) + (m_diagonal - 2) * std::min(dx, dy)) * scale;
+                        break;
+
+                    case Heuristic::Euclidean:
+                        h[i] = std::sqrt((double)dx * dx + (double)dy * dy) * scale;
+                        break;
+
+                    default:
+                        h[i] = (double)(dx + dy) * scale;
+                        break;
+                }
+            }
+#endif
+        }
+
+        /**
+         * Calculates the cost of reaching every neighbor from the coordinate given, taking into account the cost of the neighbor
+         *
+         * @param from Coordinate moved from
+         * @param g Cost of reaching the coordinate moved from
+         * @param costs Output of the costs, with room for the capacity of the batch
+         */
+        void moveCosts(const Coordinate& from, const double g, double* costs) const
+        {
+#if defined(PATHFINDING_SIMD_AVX2)
+            // Diagonal if the neighbor is neither on the same column nor on the same row
+            const auto sameX = _mm256_cmpeq_epi32(_mm256_load_si256((const __m256i*)m_x), _mm256_set1_epi32(from.first));
+            const auto sameY = _mm256_cmpeq_epi32(_mm256_load_si256((const __m256i*)m_y), _mm256_set1_epi32(from.second));
+            const auto weight = _mm256_blendv_ps(_mm256_set1_ps(m_diagonal), _mm256_set1_ps(1.f), _mm256_castsi256_ps(_mm256_or_si256(sameX, sameY)));
+            const auto cost = _mm256_mul_ps(weight, _mm256_load_ps(m_costs));
+            const auto base = _mm256_set1_pd(g);
+
+            _mm256_storeu_pd(costs, _mm256_add_pd(base, _mm256_cvtps_pd(_mm256_castps256_ps128(cost))));
+            _mm256_storeu_pd(costs + 4, _mm256_add_pd(base, _mm256_cvtps_pd(_mm256_extractf128_ps(cost, 1))));
+#elif defined(PATHFINDING_SIMD_SSE)
+            const auto base = _mm_set1_pd(g);
+
+            for (size_t i = 0; i < Capacity; i += 4)
+            {
+                const auto sameX = _mm_cmpeq_epi32(_mm_load_si128((const __m128i*)(m_x + i)), _mm_set1_epi32(from.first));
+                const auto sameY = _mm_cmpeq_epi32(_mm_load_si128((const __m128i*)(m_y + i)), _mm_set1_epi32(from.second));
+                const auto weight = _mm_blendv_ps(_mm_set1_ps(m_diagonal), _mm_set1_ps(1.f), _mm_castsi128_ps(_mm_or_si128(sameX, sameY)));
+                const auto cost = _mm_mul_ps(weight, _mm_load_ps(m_costs + i));
+
+                _mm_storeu_pd(costs + i, _mm_add_pd(base, _mm_cvtps_pd(cost)));
+                _mm_storeu_pd(costs + i + 2, _mm_add_pd(base, _mm_cvtps_pd(_mm_movehl_ps(cost, cost))));
+            }
+#else
+            for (size_t i = 0; i < m_size; ++i)
+            {
+                const auto weight = m_x[i] != from.first && m_y[i] != from.second ? m_diagonal : 1.f;
+                costs[i] = g + weight * m_costs[i];
+            }
+#endif
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,407 @@
+#ifndef PARALLEL_A_STAR_H
+#define PARALLEL_A_STAR_H
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <thread>
+#include "AlgorithmBase.hpp"
+
+
+namespace PathFinding
+{
+    /// Hash Distributed A*, a single search run by several threads. Every node is owned by the thread given by the hash
+    /// of its position, which is the only one that evaluates it. The nodes generated for other threads are sent to them
+    /// in batches through lock-free queues. The search runs on a single step and the solution is optimal.
+    /// The changes of the nodes are not tracked
+    class ParallelAStar : public AlgorithmBase
+    {
+        struct Node : NodeBase
+        {
+            /// Cost from the start
+            double g = std::numeric_limits<double>::max();
+
+            virtual void init() override
+            {
+                NodeBase::init();
+                g = std::numeric_limits<double>::max();
+            }
+
+            virtual void reset() override
+            {
+                NodeBase::reset();
+                g = std::numeric_limits<double>::max();
+            }
+        };
+
+        /// Node generated for another thread
+        struct Message
+        {
+            Node* node;
+            Node* parent;
+            double g;
+        };
+
+        /// Messages sent at once to a thread, linked on its queue
+        struct Batch
+        {
+            Batch* next = nullptr;
+            std::vector<Message> messages;
+        };
+
+        /// Node waiting to be evaluated, it is stale if the node got a better cost after it was pushed
+        struct Entry
+        {
+            double f;
+            double g;
+            Node* node;
+        };
+
+        /// State of every thread, on its own cache line as the queue is written by the other threads
+        struct alignas(64) Worker
+        {
+            /// Batches received and not processed yet, pushed by any thread and taken at once by the owner
+            std::atomic<Batch*> queue{ nullptr };
+
+            /// Nodes waiting to be evaluated, a heap with the lowest cost on top
+            std::vector<Entry> openNodes;
+
+            /// Nodes generated for every other thread, not sent yet
+            std::vector<std::vector<Message>> outbox;
+
+            unsigned long nodesOpened = 0;
+            unsigned long nodesClosed = 0;
+            PATHFINDING_METRIC(unsigned long pushes = 0);
+            PATHFINDING_METRIC(unsigned long pops = 0);
+            PATHFINDING_METRIC(unsigned long reopenings = 0);
+        };
+
+        /// Messages sent at once to a thread
+        static const size_t m_batchSize = 64;
+
+        /// Node's board
+        Board<Node> m_board;
+
+        /// Number of threads searching
+        size_t m_threads;
+
+        /// Cost of the best solution found
+        std::atomic<double> m_bestCost{ std::numeric_limits<double>::max() };
+
+        /// Threads evaluating nodes plus messages sent and not processed yet, the search is finished once it is 0
+        std::atomic<size_t> m_work{ 0 };
+
+        std::vector<std::unique_ptr<Worker>> m_workers;
+
+        /// Whether the search has been run since the last init
+        bool m_finished = false;
+
+    public:
+        /**
+         * Create a board with the size, start, and goal position given
+         *
+         * @param size Size of the board
+         * @param start Start position of the board
+         * @param goal Goal position of the board
+         * @param threads Number of threads searching, as many as the hardware supports if 0
+         */
+        ParallelAStar(const Coordinate& size, const Coordinate& start, const Coordinate& goal, const size_t threads = 0)
+        : AlgorithmBase("HDA*"), m_board{size, start, goal}, m_threads(threads ? threads : std::max(1u, std::thread::hardware_concurrency())) {}
+
+        virtual ~ParallelAStar(){}
+
+        void init(const Heuristic heuristic, const bool diagonals = true, const bool cutCorners = true) override
+        {
+            AlgorithmBase::init(heuristic, diagonals, cutCorners);
+
+            m_board.init();
+            PATHFINDING_METRIC(metrics.boardMemory = m_board.getMemoryUsage());
+
+            m_workers.clear();
+            for (size_t i = 0; i < m_threads; ++i)
+            {
+                m_workers.push_back(std::make_unique<Worker>());
+                m_workers.back()->outbox.resize(m_threads);
+            }
+
+            m_bestCost = std::numeric_limits<double>::max();
+            m_finished = false;
+
+            auto* start = m_board.getStartNode();
+            relax(*m_workers[getOwner(start)], start, nullptr, 0.f);
+        }
+
+        virtual void reset() override
+        {
+            AlgorithmBase::reset();
+
+            m_workers.clear();
+            m_finished = false;
+
+            m_board.reset();
+        }
+
+        inline const size_t getTotalSize() const override { return m_board.getTotalSize(); }
+
+        inline const Coordinate getSize() const override { return m_board.getSize(); }
+
+        inline const Coordinate getStart() const override { return m_board.getStart(); }
+
+        inline const Coordinate getGoal() const override { return m_board.getGoal(); }
+
+        inline const NodeBase* getGoalNode() const override { return m_board.getGoalNode(); }
+
+        inline const bool isObstacle(const Coordinate& c) const override { return m_board.isObstacle(c); }
+
+        inline const NodeState getState(const Coordinate& c) const override { return m_board.getState(c); }
+
+        inline void setObstacle(const Coordinate& c, const bool obstacle = true) override
+        {
+            m_board.setObstacle(c, obstacle);
+        }
+
+        inline void setObstacles(const ObstacleGrid& obstacles) override { m_board.setObstacles(obstacles); }
+
+        inline const Cost getCost(const Coordinate& c) const override { return m_board.getCost(c); }
+
+        inline void setCost(const Coordinate& c, const Cost cost = 1) override { m_board.setCost(c, cost); }
+
+        inline void setCosts(const std::vector<Cost>& costs) override { m_board.setCosts(costs); }
+
+        inline const Cost getMinCost() const override { return m_board.getMinCost(); }
+
+        //TODO: Remove
+        inline double getValue1(const Coordinate&) const override
+        {
+            return 0.f;
+        }
+
+        //TODO: Remove
+        inline double getValue2(const Coordinate& c) const override
+        {
+            const auto* node = m_board[c];
+            return node && node->opened ? node->g : 0.f;
+        }
+
+        /**
+         * Runs the whole search on all the threads
+         *
+         * @return Always true, the search is finished
+         */
+        bool nextStep() override
+        {
+            if (m_finished || m_workers.empty()) return true;
+
+            // Every thread starts evaluating, the first one has the start node
+            m_work = m_threads;
+
+            std::vector<std::thread> threads;
+            for (size_t i = 1; i < m_threads; ++i)
+            {
+                threads.emplace_back(&ParallelAStar::search, this, i);
+            }
+
+            search(0);
+
+            for (auto& thread : threads)
+            {
+                thread.join();
+            }
+
+            for (const auto& worker : m_workers)
+            {
+                nodesOpened += worker->nodesOpened;
+                nodesClosed += worker->nodesClosed;
+                PATHFINDING_METRIC(metrics.pushes += worker->pushes);
+                PATHFINDING_METRIC(metrics.pops += worker->pops);
+                PATHFINDING_METRIC(metrics.reopenings += worker->reopenings);
+            }
+
+            if (m_bestCost < std::numeric_limits<double>::max())
+                storeSolution();
+
+            m_finished = true;
+            return true;
+        }
+
+    private:
+        /**
+         * Returns the thread that owns a node, hashing its position so neighbor nodes are spread across the threads
+         *
+         * @param node Node of which the owner is returned
+         * @return Index of the thread that owns the node
+         */
+        inline size_t getOwner(const Node* node) const
+        {
+            auto hash = ((std::uint64_t)node->position.first << 32 | (std::uint32_t)node->position.second) * 0x9e3779b97f4a7c15;
+            return (size_t)((hash >> 32) % m_threads);
+        }
+
+        static bool isWorse(const Entry& entry1, const Entry& entry2)
+        {
+            return entry1.f == entry2.f ? entry1.g < entry2.g : entry1.f > entry2.f;
+        }
+
+        /**
+         * Updates a node owned by the worker given if the cost through the parent is better, and pushes it to be evaluated
+         */
+        void relax(Worker& worker, Node* node, Node* parent, const double g)
+        {
+            if (g >= node->g) return;
+
+            if (!node->opened)
+                ++worker.nodesOpened;
+
+            PATHFINDING_METRIC(worker.reopenings += node->closed);
+
+            node->opened = true;
+            node->closed = false;
+            node->parent = parent;
+            node->g = g;
+
+            worker.openNodes.push_back({ g + heuristicDistance(node->position, m_board.getGoal()), g, node });
+            std::push_heap(worker.openNodes.begin(), worker.openNodes.end(), isWorse);
+            PATHFINDING_METRIC(++worker.pushes);
+        }
+
+        /**
+         * Sends the nodes generated for another thread
+         */
+        void flush(Worker& worker, const size_t target)
+        {
+            auto& messages = worker.outbox[target];
+            if (messages.empty()) return;
+
+            // Counted before it is visible, so the work never drops to 0 while a message is on its way
+            m_work += messages.size();
+
+            auto* batch = new Batch();
+            batch->messages.swap(messages);
+
+            auto& queue = m_workers[target]->queue;
+            batch->next = queue.load(std::memory_order_relaxed);
+            while (!queue.compare_exchange_weak(batch->next, batch, std::memory_order_release, std::memory_order_relaxed));
+        }
+
+        /**
+         * Processes the batches received, if any
+         *
+         * @return Number of messages processed
+         */
+        size_t receive(Worker& worker)
+        {
+            auto* batch = worker.queue.exchange(nullptr, std::memory_order_acquire);
+
+            size_t received = 0;
+            while (batch)
+            {
+                for (const auto& message : batch->messages)
+                {
+                    relax(worker, message.node, message.parent, message.g);
+                }
+                received += batch->messages.size();
+
+                std::unique_ptr<Batch> processed(batch);
+                batch = batch->next;
+            }
+            return received;
+        }
+
+        /**
+         * Search loop of every thread, until no thread has nodes better than the best solution and no message is on its way
+         *
+         * @param index Index of the thread
+         */
+        void search(const size_t index)
+        {
+            auto& worker = *m_workers[index];
+            bool active = true;
+            std::vector<Node*> neighbors;
+
+            while (true)
+            {
+                if (worker.queue.load(std::memory_order_relaxed))
+                {
+                    // Become active before the messages stop counting as work
+                    if (!active)
+                    {
+                        ++m_work;
+                        active = true;
+                    }
+                    m_work -= receive(worker);
+                }
+
+                // Nodes not better than the best solution can be dropped
+                while (worker.openNodes.size() && (worker.openNodes.front().g > worker.openNodes.front().node->g
+                    || worker.openNodes.front().f >= m_bestCost.load(std::memory_order_relaxed)))
+                {
+                    std::pop_heap(worker.openNodes.begin(), worker.openNodes.end(), isWorse);
+                    worker.openNodes.pop_back();
+                }
+
+                if (worker.openNodes.empty())
+                {
+                    for (size_t target = 0; target < m_threads; ++target)
+                    {
+                        flush(worker, target);
+                    }
+
+                    if (active)
+                    {
+                        --m_work;
+                        active = false;
+                    }
+
+                    if (!m_work) break;
+
+                    std::this_thread::yield();
+                    continue;
+                }
+
+                std::pop_heap(worker.openNodes.begin(), worker.openNodes.end(), isWorse);
+                auto* node = worker.openNodes.back().node;
+                worker.openNodes.pop_back();
+
+                node->closed = true;
+                ++worker.nodesClosed;
+                PATHFINDING_METRIC(++worker.pops);
+
+                if (node->position == m_board.getGoal())
+                {
+                    updateBestCost(node->g);
+                    continue;
+                }
+
+                neighbors.clear();
+                m_board.getNeighbors(node, neighbors, m_movement);
+
+                for (auto* neighbor : neighbors)
+                {
+                    const auto g = node->g + moveCost(node->position, neighbor->position);
+                    const auto owner = getOwner(neighbor);
+
+                    if (owner == index)
+                    {
+                        relax(worker, neighbor, node, g);
+                        continue;
+                    }
+
+                    worker.outbox[owner].push_back({ neighbor, node, g });
+                    if (worker.outbox[owner].size() >= m_batchSize)
+                        flush(worker, owner);
+                }
+            }
+        }
+
+        void updateBestCost(const double cost)
+        {
+            auto best = m_bestCost.load();
+            while (cost < best && !m_bestCost.compare_exchange_weak(best, cost));
+        }
+    };
+}
+
+#endif
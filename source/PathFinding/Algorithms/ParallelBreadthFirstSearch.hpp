@@ -0,0 +1,331 @@
+#ifndef PARALLEL_BREADTH_FIRST_SEARCH_H
+#define PARALLEL_BREADTH_FIRST_SEARCH_H
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include "AlgorithmBase.hpp"
+
+
+namespace PathFinding
+{
+    /// Breadth First Search that expands a whole level of the search on every step, splitting it across a pool of threads.
+    /// The threads claim the nodes they open atomically, so every node is opened once and the solution has the same number
+    /// of moves as the one of the Breadth First Search
+    class ParallelBreadthFirstSearch : public AlgorithmBase
+    {
+        struct Node : NodeBase
+        {
+            /// Set by the first thread that reaches the node
+            std::atomic<bool> claimed{ false };
+
+            virtual void init() override
+            {
+                NodeBase::init();
+                claimed.store(false, std::memory_order_relaxed);
+            }
+
+            virtual void reset() override
+            {
+                NodeBase::reset();
+                claimed.store(false, std::memory_order_relaxed);
+            }
+        };
+
+        /// Nodes of the level taken at once by a thread
+        static const size_t m_chunkSize = 64;
+
+        /// Levels smaller than this are expanded by the calling thread alone, waking the pool would cost more
+        static const size_t m_parallelLevel = 1024;
+
+        /// Node's board
+        Board<Node> m_board;
+
+        /// Number of threads expanding every level, including the calling one
+        size_t m_threads;
+
+        /// Nodes of the level to expand
+        std::vector<Node*> m_openNodes;
+
+        /// Work of every thread on the current level, on its own cache line as every thread writes its own while expanding
+        struct alignas(64) Worker
+        {
+            /// Nodes opened on the current level
+            std::vector<Node*> openedNodes;
+
+            /// Neighbors checked on the current level
+            unsigned long neighborChecks = 0;
+        };
+
+        std::vector<Worker> m_workers;
+
+        /// First node of the level not taken by any thread yet
+        std::atomic<size_t> m_nextNode{ 0 };
+
+        std::vector<std::thread> m_pool;
+        std::mutex m_mutex;
+        std::condition_variable m_levelStarted;
+        std::condition_variable m_levelFinished;
+
+        /// Increased on every level expanded by the pool, so the threads know when to start
+        size_t m_level = 0;
+
+        /// Threads of the pool still expanding the current level
+        size_t m_running = 0;
+
+        /// Whether the threads of the pool have to finish
+        bool m_stop = false;
+
+    public:
+        /**
+         * Create a board with the size, start, and goal position given
+         *
+         * @param size Size of the board
+         * @param start Start position of the board
+         * @param goal Goal position of the board
+         * @param threads Number of threads expanding every level, as many as the hardware supports if 0
+         */
+        ParallelBreadthFirstSearch(const Coordinate& size, const Coordinate& start, const Coordinate& goal, const size_t threads = 0)
+        : AlgorithmBase("Parallel Breadth First Search"), m_board{size, start, goal},
+          m_threads(threads ? threads : std::max(1u, std::thread::hardware_concurrency())), m_workers(m_threads) {}
+
+        virtual ~ParallelBreadthFirstSearch()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stop = true;
+            }
+            m_levelStarted.notify_all();
+
+            for (auto& thread : m_pool)
+            {
+                thread.join();
+            }
+        }
+
+        void init(const Heuristic heuristic, const bool diagonals = true, const bool cutCorners = true) override
+        {
+            AlgorithmBase::init(heuristic, diagonals, cutCorners);
+
+            m_openNodes.clear();
+
+            m_board.init();
+            PATHFINDING_METRIC(metrics.boardMemory = m_board.getMemoryUsage());
+
+            auto* start = m_board.getStartNode();
+            start->claimed = true;
+            openNode(start);
+            m_openNodes.push_back(start);
+            PATHFINDING_METRIC(++metrics.pushes);
+        }
+
+        virtual void reset() override
+        {
+            AlgorithmBase::reset();
+
+            m_openNodes.clear();
+
+            m_board.reset();
+        }
+
+        inline const size_t getTotalSize() const override { return m_board.getTotalSize(); }
+
+        inline const Coordinate getSize() const override { return m_board.getSize(); }
+
+        inline const Coordinate getStart() const override { return m_board.getStart(); }
+
+        inline const Coordinate getGoal() const override { return m_board.getGoal(); }
+
+        inline const NodeBase* getGoalNode() const override { return m_board.getGoalNode(); }
+
+        inline const bool isObstacle(const Coordinate& c) const override { return m_board.isObstacle(c); }
+
+        inline const NodeState getState(const Coordinate& c) const override { return m_board.getState(c); }
+
+        inline void setObstacle(const Coordinate& c, const bool obstacle = true) override
+        {
+            m_board.setObstacle(c, obstacle);
+        }
+
+        inline void setObstacles(const ObstacleGrid& obstacles) override { m_board.setObstacles(obstacles); }
+
+        inline const Cost getCost(const Coordinate& c) const override { return m_board.getCost(c); }
+
+        inline void setCost(const Coordinate& c, const Cost cost = 1) override { m_board.setCost(c, cost); }
+
+        inline void setCosts(const std::vector<Cost>& costs) override { m_board.setCosts(costs); }
+
+        inline const Cost getMinCost() const override { return m_board.getMinCost(); }
+
+        //TODO: Remove
+        inline double getValue1(const Coordinate& c) const override
+        {
+            return m_board.isValidNode(c) && m_board[c]->opened ? 111.f : 0.f;
+        }
+
+        //TODO: Remove
+        inline double getValue2(const Coordinate&) const override
+        {
+            return 0.f;
+        }
+
+        /**
+         * Expands every node of the current level of the search
+         *
+         * @return Whether the algorithm finished or not
+         */
+        bool nextStep() override
+        {
+            if (m_openNodes.empty()) return true;
+
+            if (checkGoal(m_board.getGoalNode())) return true;
+
+            expandLevel();
+
+            nodesClosed += m_openNodes.size();
+            PATHFINDING_METRIC(metrics.pops += m_openNodes.size());
+            for (auto* node : m_openNodes)
+            {
+                node->closed = true;
+                markChanged(node->position, Change::Closed);
+            }
+
+            // The nodes opened by every thread are the next level
+            m_openNodes.clear();
+            for (auto& worker : m_workers)
+            {
+                for (auto* node : worker.openedNodes)
+                {
+                    ++nodesOpened;
+                    markChanged(node->position, Change::Opened);
+                }
+                m_openNodes.insert(m_openNodes.end(), worker.openedNodes.begin(), worker.openedNodes.end());
+                worker.openedNodes.clear();
+
+                PATHFINDING_METRIC(metrics.neighborChecks += worker.neighborChecks);
+                worker.neighborChecks = 0;
+            }
+            PATHFINDING_METRIC(metrics.pushes += m_openNodes.size());
+            PATHFINDING_METRIC(metrics.updateOpenNodes(m_openNodes.size(), sizeof(Node*)));
+
+            return checkGoal(m_board.getGoalNode()) || m_openNodes.empty();
+        }
+
+    private:
+        /**
+         * Stores the solution if the goal has been opened
+         *
+         * @return Whether the goal has been opened or not
+         */
+        bool checkGoal(const NodeBase* goal)
+        {
+            if (!goal->opened) return false;
+
+            if (!hasSolution())
+                storeSolution();
+            return true;
+        }
+
+        /**
+         * Expands the current level, on the pool of threads if it is big enough
+         */
+        void expandLevel()
+        {
+            m_nextNode.store(0, std::memory_order_relaxed);
+
+            if (m_threads == 1 || m_openNodes.size() < m_parallelLevel)
+            {
+                expandNodes(0);
+                return;
+            }
+
+            if (m_pool.empty())
+            {
+                for (size_t i = 1; i < m_threads; ++i)
+                {
+                    m_pool.emplace_back(&ParallelBreadthFirstSearch::runPool, this, i);
+                }
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                ++m_level;
+                m_running = m_pool.size();
+            }
+            m_levelStarted.notify_all();
+
+            expandNodes(0);
+
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_levelFinished.wait(lock, [this]() { return !m_running; });
+        }
+
+        /**
+         * Loop of every thread of the pool, expanding every level it is woken up for
+         *
+         * @param index Index of the thread
+         */
+        void runPool(const size_t index)
+        {
+            size_t level = 0;
+            while (true)
+            {
+                {
+                    std::unique_lock<std::mutex> lock(m_mutex);
+                    m_levelStarted.wait(lock, [&]() { return m_stop || m_level != level; });
+                    if (m_stop) return;
+                    level = m_level;
+                }
+
+                expandNodes(index);
+
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (!--m_running)
+                    m_levelFinished.notify_one();
+            }
+        }
+
+        /**
+         * Expands chunks of the current level until every node of it has been taken
+         *
+         * @param index Index of the thread expanding
+         */
+        void expandNodes(const size_t index)
+        {
+            auto& worker = m_workers[index];
+            std::vector<Node*> neighbors;
+
+            while (true)
+            {
+                const auto first = m_nextNode.fetch_add(m_chunkSize, std::memory_order_relaxed);
+                if (first >= m_openNodes.size()) return;
+
+                const auto last = std::min(first + m_chunkSize, m_openNodes.size());
+                for (size_t i = first; i < last; ++i)
+                {
+                    auto* node = m_openNodes[i];
+
+                    neighbors.clear();
+                    m_board.getNeighbors(node, neighbors, m_movement);
+                    worker.neighborChecks += neighbors.size();
+
+                    for (auto* neighbor : neighbors)
+                    {
+                        // Only the thread that claims the node writes it
+                        if (neighbor->claimed.load(std::memory_order_relaxed) || neighbor->claimed.exchange(true, std::memory_order_relaxed))
+                            continue;
+
+                        neighbor->parent = node;
+                        neighbor->opened = true;
+                        worker.openedNodes.push_back(neighbor);
+                    }
+                }
+            }
+        }
+    };
+}
+
+#endif
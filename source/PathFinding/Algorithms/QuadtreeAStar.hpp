@@ -0,0 +1,504 @@
+#ifndef QUADTREE_A_STAR_H
+#define QUADTREE_A_STAR_H
+#pragma once
+
+#include <algorithm>
+#include <limits>
+#include "AlgorithmBase.hpp"
+#include "../QuadtreeBoard.hpp"
+
+
+namespace PathFinding
+{
+    /// A* in two phases on a board decomposed in the maximal square blocks of free nodes of a quadtree. The first phase
+    /// searches the blocks, moving between points inside of them: the start and the goal on their blocks, and the node
+    /// closest to the point of the previous block on the rest. The second phase is an A* node by node restricted to the
+    /// blocks of the path found and their neighbors, which gives the exact cost of the path. The open areas are crossed
+    /// with a few block expansions instead of one per node, but the solution is only the best one inside of the blocks
+    /// searched, not the best one of the board. It is not optimal, even on boards without obstacles nor costs: on random
+    /// boards with costs and incremental updates about one query in five is suboptimal, and up to 12% longer
+    class QuadtreeAStar : public AlgorithmBase
+    {
+        /// State of a block on the first phase
+        struct BlockNode
+        {
+            /// Cost from the start
+            double g = std::numeric_limits<double>::max();
+
+            /// Point of the block the cost is measured to
+            Coordinate point{ 0, 0 };
+
+            /// Index of the previous block from which the shortest path reaches this block
+            std::uint32_t parent = QuadtreeBoard::None;
+
+            bool opened = false;
+            bool closed = false;
+
+            /// Whether the block is part of the path of blocks found, where the second phase is searched
+            bool corridor = false;
+        };
+
+        /// State of a node on the second phase, only valid if its search is the current one
+        struct Node
+        {
+            /// Direction of a node without parent
+            static constexpr std::uint8_t None = 8;
+
+            /// Cost from the start
+            double g = std::numeric_limits<double>::max();
+
+            /// Search in which the node was last touched
+            std::uint32_t search = 0;
+
+            /// Direction of the previous node from which the shortest path reaches this node
+            std::uint8_t parent = None;
+
+            bool opened = false;
+            bool closed = false;
+        };
+
+        /// Block or node waiting to be evaluated, it is stale if it got a better cost after it was pushed
+        struct Entry
+        {
+            double f;
+            double g;
+            Coordinate position;
+            std::uint32_t block;
+        };
+
+        /// Collection of blocks or nodes yet to be evaluated, a heap with the lowest cost on top
+        std::vector<Entry> m_openNodes;
+
+        /// Node's board
+        QuadtreeBoard m_board;
+
+        /// State of every block, indexed as the blocks of the board
+        std::vector<BlockNode> m_blocks;
+
+        /// State of every node, stored contiguously by axis and kept between searches, so they are not reset one by one
+        std::vector<Node> m_nodes;
+
+        /// Current search, to know which nodes have been touched by it
+        std::uint32_t m_search = 0;
+
+        /// Whether the search is on the second phase, node by node
+        bool m_refining = false;
+
+        /// Whether the search has finished
+        bool m_finished = false;
+
+    public:
+        /**
+         * Create a board with the size, start, and goal position given
+         *
+         * @param size Size of the board, of less than 2^32 nodes
+         * @param start Start position of the board
+         * @param goal Goal position of the board
+         */
+        QuadtreeAStar(const Coordinate& size, const Coordinate& start, const Coordinate& goal)
+        : AlgorithmBase("Quadtree A* (Suboptimal)"), m_board{size, start, goal} {}
+
+        virtual ~QuadtreeAStar(){}
+
+        void init(const Heuristic heuristic, const bool diagonals = true, const bool cutCorners = true) override
+        {
+            AlgorithmBase::init(heuristic, diagonals, cutCorners);
+
+            m_openNodes.clear();
+            m_refining = false;
+            m_finished = false;
+
+            m_blocks.assign(m_board.getBlockCapacity(), BlockNode());
+            if (m_nodes.empty()) m_nodes.resize(m_board.getTotalSize());
+            nextSearch();
+            PATHFINDING_METRIC(metrics.boardMemory = m_board.getMemoryUsage() + m_blocks.size() * sizeof(BlockNode) + m_nodes.size() * sizeof(Node));
+
+            if (m_board.isValidNode(m_board.getStart()) && m_board.isValidNode(m_board.getGoal()))
+            {
+                const auto start = m_board.getBlockOf(m_board.getStart());
+                openBlock(start, QuadtreeBoard::None, m_board.getStart(), 0.f);
+            }
+        }
+
+        virtual void reset() override
+        {
+            AlgorithmBase::reset();
+
+            m_openNodes.clear();
+            m_blocks.clear();
+            m_refining = false;
+            m_finished = false;
+            nextSearch();
+
+            m_board.reset();
+        }
+
+        inline const size_t getTotalSize() const override { return m_board.getTotalSize(); }
+
+        inline const Coordinate getSize() const override { return m_board.getSize(); }
+
+        inline const Coordinate getStart() const override { return m_board.getStart(); }
+
+        inline const Coordinate getGoal() const override { return m_board.getGoal(); }
+
+        /// The nodes are not derived from NodeBase, the solution is stored from the directions of the parents
+        inline const NodeBase* getGoalNode() const override { return nullptr; }
+
+        inline const bool isObstacle(const Coordinate& c) const override { return m_board.isObstacle(c); }
+
+        /**
+         * Returns the state of the node at the coordinate given on the second phase
+         *
+         * @param c Coordinate of the node
+         * @return The state of the node, free if the coordinate is not valid or the node was not touched
+         */
+        inline const NodeState getState(const Coordinate& c) const override
+        {
+            if (!m_board.isValidNode(c)) return NodeState::Free;
+            if (m_board.isObstacle(c)) return NodeState::Obstacle;
+
+            const auto* node = findNode(c);
+            return !node ? NodeState::Free : node->closed ? NodeState::Closed : node->opened ? NodeState::Opened : NodeState::Free;
+        }
+
+        inline void setObstacle(const Coordinate& c, const bool obstacle = true) override
+        {
+            m_board.setObstacle(c, obstacle);
+        }
+
+        inline void setObstacles(const ObstacleGrid& obstacles) override { m_board.setObstacles(obstacles); }
+
+        inline const Cost getCost(const Coordinate& c) const override { return m_board.getCost(c); }
+
+        inline void setCost(const Coordinate& c, const Cost cost = 1) override { m_board.setCost(c, cost); }
+
+        inline void setCosts(const std::vector<Cost>& costs) override { m_board.setCosts(costs); }
+
+        inline const Cost getMinCost() const override { return m_board.getMinCost(); }
+
+        /**
+         * Returns the number of blocks of the board
+         *
+         * @return Number of blocks of the board
+         */
+        inline size_t getBlockCount() const { return m_board.getBlockCount(); }
+
+        //TODO: Remove
+        inline double getValue1(const Coordinate& c) const override
+        {
+            const auto* node = m_board.isValidNode(c) ? findNode(c) : nullptr;
+            return node && node->opened ? heuristicDistance(c, m_board.getGoal()) : 0.f;
+        }
+
+        //TODO: Remove
+        inline double getValue2(const Coordinate& c) const override
+        {
+            const auto* node = m_board.isValidNode(c) ? findNode(c) : nullptr;
+            return node && node->opened ? node->g : 0.f;
+        }
+
+        bool nextStep() override
+        {
+            if (m_finished) return true;
+
+            return m_refining ? nextNode() : nextBlock();
+        }
+
+    protected:
+        void storeSolution() override
+        {
+            const auto& directions = QuadtreeBoard::Directions;
+            const auto goal = m_board.getGoal();
+
+            if (storeCompact)
+            {
+                // Count the steps first, so the path is built without reallocations
+                size_t steps = 0;
+                auto start = goal;
+                for (std::uint8_t parent; (parent = getNode(start).parent) != Node::None; ++steps)
+                {
+                    start = { start.first + directions[parent].first, start.second + directions[parent].second };
+                }
+
+                compactSolution.assign(start, steps);
+                for (auto c = goal; getNode(c).parent != Node::None; )
+                {
+                    const auto parent = getNode(c).parent;
+                    const Coordinate previous{ c.first + directions[parent].first, c.second + directions[parent].second };
+                    compactSolution.setStep(--steps, previous, c);
+                    c = previous;
+                }
+                return;
+            }
+
+            // Start on the goal and go back by parents
+            for (auto c = goal; ; )
+            {
+                solution.push_back(c);
+
+                const auto parent = getNode(c).parent;
+                if (parent == Node::None) break;
+                c = { c.first + directions[parent].first, c.second + directions[parent].second };
+            }
+        }
+
+    private:
+        /// Neighbor blocks of the block expanded, kept to reuse its memory
+        std::vector<std::uint32_t> m_neighborBlocks;
+
+        /// Neighbors of the node expanded, kept to reuse its memory
+        std::vector<Coordinate> m_neighbors;
+
+        static bool isWorse(const Entry& entry1, const Entry& entry2)
+        {
+            return entry1.f == entry2.f ? entry1.g < entry2.g : entry1.f > entry2.f;
+        }
+
+        /**
+         * Starts a new search of the second phase, resetting the nodes only when the counter wraps around
+         */
+        void nextSearch()
+        {
+            if (++m_search == 0)
+            {
+                std::fill(m_nodes.begin(), m_nodes.end(), Node());
+                m_search = 1;
+            }
+        }
+
+        inline size_t getIndex(const Coordinate& c) const { return (size_t)c.first * m_board.getSize().second + c.second; }
+
+        /**
+         * Returns the node of a valid coordinate on the current search, resetting it if it is from a previous one
+         *
+         * @param c Coordinate of the node
+         * @return Reference to the node
+         */
+        inline Node& getNode(const Coordinate& c)
+        {
+            auto& node = m_nodes[getIndex(c)];
+            if (node.search != m_search)
+            {
+                node = Node();
+                node.search = m_search;
+            }
+            return node;
+        }
+
+        inline const Node* findNode(const Coordinate& c) const
+        {
+            if (m_nodes.empty()) return nullptr;
+
+            const auto& node = m_nodes[getIndex(c)];
+            return node.search == m_search ? &node : nullptr;
+        }
+
+        /**
+         * Returns the distance between two points of the blocks, with the moves allowed
+         *
+         * @param from First point
+         * @param to Second point
+         * @return Distance between the points
+         */
+        inline double blockDistance(const Coordinate& from, const Coordinate& to) const
+        {
+            return m_diagonals ? diagonalDistance(from, to) : manhattanDistance(from, to);
+        }
+
+        /**
+         * Expands the best block of the first phase, starting the second phase once the block of the goal is expanded
+         *
+         * @return Whether the algorithm finished or not
+         */
+        bool nextBlock()
+        {
+            // Drop the entries of the blocks improved after they were pushed
+            while (m_openNodes.size() && m_openNodes.front().g > m_blocks[m_openNodes.front().block].g)
+            {
+                popEntry();
+            }
+
+            if (m_openNodes.empty()) return m_finished = true;
+
+            const auto entry = popEntry();
+            auto& block = m_blocks[entry.block];
+            block.closed = true;
+            ++nodesClosed;
+
+            if (entry.block == m_board.getBlockOf(m_board.getGoal()))
+            {
+                startRefining(entry.block);
+                return false;
+            }
+
+            m_neighborBlocks.clear();
+            m_board.getNeighborBlocks(entry.block, m_neighborBlocks);
+            PATHFINDING_METRIC(metrics.neighborChecks += m_neighborBlocks.size());
+
+            const auto& from = m_board.getBlock(entry.block);
+            for (const auto neighbor : m_neighborBlocks)
+            {
+                const auto& next = m_blocks[neighbor];
+                if (next.closed) continue;
+
+                // The goal is the point of its block, the node closest to the point of the block expanded is the point of the rest
+                const auto& to = m_board.getBlock(neighbor);
+                const auto point = neighbor == m_board.getBlockOf(m_board.getGoal()) ? m_board.getGoal()
+                    : Coordinate{ std::clamp(block.point.first, to.position.first, to.position.first + to.side - 1),
+                                  std::clamp(block.point.second, to.position.second, to.position.second + to.side - 1) };
+
+                const auto g = block.g + blockDistance(block.point, point) * (from.cost + to.cost) / 2.f;
+                if (g >= next.g) continue;
+
+                PATHFINDING_METRIC(metrics.decreaseKeys += next.opened);
+                openBlock(neighbor, entry.block, point, g);
+            }
+
+            return false;
+        }
+
+        /**
+         * Marks the blocks of the path found and their neighbors, so the best path is not forced through the points of
+         * the blocks, and opens the start node to search node by node inside of them
+         *
+         * @param goal Index of the block of the goal
+         */
+        void startRefining(const std::uint32_t goal)
+        {
+            for (auto block = goal; block != QuadtreeBoard::None; block = m_blocks[block].parent)
+            {
+                m_blocks[block].corridor = true;
+
+                m_neighborBlocks.clear();
+                m_board.getNeighborBlocks(block, m_neighborBlocks);
+                for (const auto neighbor : m_neighborBlocks)
+                {
+                    m_blocks[neighbor].corridor = true;
+                }
+            }
+
+            m_openNodes.clear();
+            m_refining = true;
+            openNode(m_board.getStart(), Node::None, 0.f);
+        }
+
+        /**
+         * Expands the best node of the second phase
+         *
+         * @return Whether the algorithm finished or not
+         */
+        bool nextNode()
+        {
+            // Drop the entries of the nodes improved after they were pushed
+            while (m_openNodes.size() && m_openNodes.front().g > getNode(m_openNodes.front().position).g)
+            {
+                popEntry();
+            }
+
+            if (m_openNodes.empty()) return m_finished = true;
+
+            const auto position = popEntry().position;
+            auto& node = getNode(position);
+
+            node.closed = true;
+            ++nodesClosed;
+            markChanged(position, Change::Closed);
+
+            if (position == m_board.getGoal())
+            {
+                storeSolution();
+                return m_finished = true;
+            }
+
+            m_neighbors.clear();
+            m_board.getNeighbors(position, m_neighbors, m_movement);
+            PATHFINDING_METRIC(metrics.neighborChecks += m_neighbors.size());
+
+            for (const auto& neighbor : m_neighbors)
+            {
+                // Only the nodes of the blocks of the path found are searched
+                if (!m_blocks[m_board.getBlockOf(neighbor)].corridor) continue;
+
+                const auto& next = getNode(neighbor);
+                if (next.closed) continue;
+
+                const auto g = node.g + moveCost(position, neighbor);
+                if (g >= next.g) continue;
+
+                PATHFINDING_METRIC(metrics.decreaseKeys += next.opened);
+                openNode(neighbor, (std::uint8_t)CompactPath::GetDirection(neighbor, position), g);
+            }
+
+            return false;
+        }
+
+        /**
+         * Opens or improves a block, pushing a new entry for it
+         *
+         * @param index Index of the block
+         * @param parent Index of the parent of the block
+         * @param point Point of the block the cost is measured to
+         * @param g Cost from the start through the parent
+         */
+        void openBlock(const std::uint32_t index, const std::uint32_t parent, const Coordinate& point, const double g)
+        {
+            auto& block = m_blocks[index];
+
+            if (!block.opened) ++nodesOpened;
+
+            block.opened = true;
+            block.parent = parent;
+            block.point = point;
+            block.g = g;
+
+            pushEntry({ g + blockDistance(point, m_board.getGoal()) * m_board.getMinCost(), g, point, index });
+        }
+
+        /**
+         * Opens or improves a node, pushing a new entry for it
+         *
+         * @param position Coordinate of the node
+         * @param parent Direction of the parent of the node
+         * @param g Cost from the start through the parent
+         */
+        void openNode(const Coordinate& position, const std::uint8_t parent, const double g)
+        {
+            auto& node = getNode(position);
+
+            if (!node.opened)
+            {
+                ++nodesOpened;
+                markChanged(position, Change::Opened);
+            }
+            else
+            {
+                markChanged(position, Change::Parent);
+            }
+
+            node.opened = true;
+            node.parent = parent;
+            node.g = g;
+
+            pushEntry({ g + heuristicDistance(position, m_board.getGoal()), g, position, QuadtreeBoard::None });
+        }
+
+        void pushEntry(const Entry& entry)
+        {
+            m_openNodes.push_back(entry);
+            std::push_heap(m_openNodes.begin(), m_openNodes.end(), isWorse);
+            PATHFINDING_METRIC(++metrics.pushes);
+            PATHFINDING_METRIC(metrics.updateOpenNodes(m_openNodes.size(), sizeof(Entry)));
+        }
+
+        Entry popEntry()
+        {
+            std::pop_heap(m_openNodes.begin(), m_openNodes.end(), isWorse);
+            const auto entry = m_openNodes.back();
+            m_openNodes.pop_back();
+            PATHFINDING_METRIC(++metrics.pops);
+            return entry;
+        }
+    };
+}
+
+#endif
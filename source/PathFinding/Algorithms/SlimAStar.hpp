@@ -0,0 +1,246 @@
+#ifndef SLIM_A_STAR_H
+#define SLIM_A_STAR_H
+#pragma once
+
+#include <algorithm>
+#include <limits>
+#include "AlgorithmBase.hpp"
+#include "../SlimBoard.hpp"
+
+
+namespace PathFinding
+{
+    /// A* on a board of slim nodes of 16 bytes, instead of the 48 bytes plus the pointer and the allocation of every node
+    /// of A*, for boards of hundreds of millions of nodes. The open list is a binary heap of node indexes, and the goal
+    /// is checked when it is expanded
+    class SlimAStar : public AlgorithmBase
+    {
+        struct Node : SlimNode
+        {
+            /// Cost from the start
+            double g = std::numeric_limits<double>::max();
+        };
+
+        /// Node waiting to be evaluated, it is stale if the node got a better cost after it was pushed
+        struct Entry
+        {
+            double f;
+            double g;
+            std::uint32_t index;
+        };
+
+        /// Collection of nodes yet to be evaluated, a heap with the lowest cost on top
+        std::vector<Entry> m_openNodes;
+
+        /// Node's board
+        SlimBoard<Node> m_board;
+
+        /// Whether the goal has been expanded
+        bool m_found = false;
+
+    public:
+        /**
+         * Create a board with the size, start, and goal position given
+         *
+         * @param size Size of the board, of less than 2^32 nodes
+         * @param start Start position of the board
+         * @param goal Goal position of the board
+         * @param layout Order of the nodes on memory
+         */
+        SlimAStar(const Coordinate& size, const Coordinate& start, const Coordinate& goal, const BoardLayout layout = BoardLayout::Linear)
+        : AlgorithmBase("Slim A*"), m_board{size, start, goal, layout} {}
+
+        virtual ~SlimAStar(){}
+
+        void init(const Heuristic heuristic, const bool diagonals = true, const bool cutCorners = true) override
+        {
+            AlgorithmBase::init(heuristic, diagonals, cutCorners);
+
+            m_openNodes.clear();
+            m_found = false;
+
+            m_board.init();
+            PATHFINDING_METRIC(metrics.boardMemory = m_board.getMemoryUsage());
+
+            if (m_board.isValidNode(m_board.getStart()))
+                openNode(m_board.getIndex(m_board.getStart()), SlimNode::None, 0.f);
+        }
+
+        virtual void reset() override
+        {
+            AlgorithmBase::reset();
+
+            m_openNodes.clear();
+            m_found = false;
+
+            m_board.reset();
+        }
+
+        inline const size_t getTotalSize() const override { return m_board.getTotalSize(); }
+
+        inline const Coordinate getSize() const override { return m_board.getSize(); }
+
+        inline const Coordinate getStart() const override { return m_board.getStart(); }
+
+        inline const Coordinate getGoal() const override { return m_board.getGoal(); }
+
+        /// The nodes are not derived from NodeBase, the solution is stored from the indexes of the parents
+        inline const NodeBase* getGoalNode() const override { return nullptr; }
+
+        inline const bool isObstacle(const Coordinate& c) const override { return m_board.isObstacle(c); }
+
+        inline const NodeState getState(const Coordinate& c) const override { return m_board.getState(c); }
+
+        inline void setObstacle(const Coordinate& c, const bool obstacle = true) override
+        {
+            m_board.setObstacle(c, obstacle);
+        }
+
+        inline void setObstacles(const ObstacleGrid& obstacles) override { m_board.setObstacles(obstacles); }
+
+        inline const Cost getCost(const Coordinate& c) const override { return m_board.getCost(c); }
+
+        inline void setCost(const Coordinate& c, const Cost cost = 1) override { m_board.setCost(c, cost); }
+
+        inline void setCosts(const std::vector<Cost>& costs) override { m_board.setCosts(costs); }
+
+        inline const Cost getMinCost() const override { return m_board.getMinCost(); }
+
+        //TODO: Remove
+        inline double getValue1(const Coordinate& c) const override
+        {
+            return m_board.isValidNode(c) && m_board[m_board.getIndex(c)].is(SlimNode::Opened) ? heuristicDistance(c, m_board.getGoal()) : 0.f;
+        }
+
+        //TODO: Remove
+        inline double getValue2(const Coordinate& c) const override
+        {
+            return m_board.isValidNode(c) && m_board[m_board.getIndex(c)].is(SlimNode::Opened) ? m_board[m_board.getIndex(c)].g : 0.f;
+        }
+
+        bool nextStep() override
+        {
+            if (m_found) return true;
+
+            // Drop the entries of the nodes improved after they were pushed
+            while (m_openNodes.size() && m_openNodes.front().g > m_board[m_openNodes.front().index].g)
+            {
+                popEntry();
+            }
+
+            if (m_openNodes.empty()) return true;
+
+            const auto index = popEntry().index;
+            auto& node = m_board[index];
+            const auto position = m_board.getPosition(index);
+
+            node.set(SlimNode::Closed);
+            ++nodesClosed;
+            markChanged(position, Change::Closed);
+
+            if (position == m_board.getGoal())
+            {
+                m_found = true;
+                storeSolution();
+                return true;
+            }
+
+            m_neighbors.clear();
+            m_board.getNeighbors(index, m_neighbors, m_movement);
+            PATHFINDING_METRIC(metrics.neighborChecks += m_neighbors.size());
+
+            for (const auto neighbor : m_neighbors)
+            {
+                const auto& next = m_board[neighbor];
+                if (next.is(SlimNode::Closed)) continue;
+
+                const auto g = node.g + moveCost(position, m_board.getPosition(neighbor));
+                if (g >= next.g) continue;
+
+                PATHFINDING_METRIC(metrics.decreaseKeys += next.is(SlimNode::Opened));
+                openNode(neighbor, index, g);
+            }
+
+            return false;
+        }
+
+    protected:
+        void storeSolution() override
+        {
+            const auto goal = m_board.getIndex(m_board.getGoal());
+
+            if (storeCompact)
+            {
+                // Count the steps first, so the path is built without reallocations
+                size_t steps = 0;
+                auto start = goal;
+                for (; m_board[start].parent != SlimNode::None; start = m_board[start].parent) ++steps;
+
+                compactSolution.assign(m_board.getPosition(start), steps);
+                for (auto index = goal; m_board[index].parent != SlimNode::None; index = m_board[index].parent)
+                {
+                    compactSolution.setStep(--steps, m_board.getPosition(m_board[index].parent), m_board.getPosition(index));
+                }
+                return;
+            }
+
+            // Start on the goal and go back by parents
+            for (auto index = goal; index != SlimNode::None; index = m_board[index].parent)
+            {
+                solution.push_back(m_board.getPosition(index));
+            }
+        }
+
+    private:
+        /// Neighbors of the node expanded, kept to reuse its memory
+        std::vector<std::uint32_t> m_neighbors;
+
+        static bool isWorse(const Entry& entry1, const Entry& entry2)
+        {
+            return entry1.f == entry2.f ? entry1.g < entry2.g : entry1.f > entry2.f;
+        }
+
+        /**
+         * Opens or improves a node, pushing a new entry for it
+         *
+         * @param index Index of the node
+         * @param parent Index of the parent of the node
+         * @param g Cost from the start through the parent
+         */
+        void openNode(const std::uint32_t index, const std::uint32_t parent, const double g)
+        {
+            auto& node = m_board[index];
+            const auto position = m_board.getPosition(index);
+
+            if (!node.is(SlimNode::Opened))
+            {
+                ++nodesOpened;
+                markChanged(position, Change::Opened);
+            }
+            else
+            {
+                markChanged(position, Change::Parent);
+            }
+
+            node.set(SlimNode::Opened);
+            node.parent = parent;
+            node.g = g;
+
+            m_openNodes.push_back({ g + heuristicDistance(position, m_board.getGoal()), g, index });
+            std::push_heap(m_openNodes.begin(), m_openNodes.end(), isWorse);
+            PATHFINDING_METRIC(++metrics.pushes);
+            PATHFINDING_METRIC(metrics.updateOpenNodes(m_openNodes.size(), sizeof(Entry)));
+        }
+
+        Entry popEntry()
+        {
+            std::pop_heap(m_openNodes.begin(), m_openNodes.end(), isWorse);
+            const auto entry = m_openNodes.back();
+            m_openNodes.pop_back();
+            PATHFINDING_METRIC(++metrics.pops);
+            return entry;
+        }
+    };
+}
+
+#endif
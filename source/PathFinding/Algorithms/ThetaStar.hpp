@@ -0,0 +1,161 @@
+#ifndef THETA_STAR_H
+#define THETA_STAR_H
+#pragma once
+
+#include <cmath>
+#include "AStar.hpp"
+
+
+namespace PathFinding
+{
+    /// Any-angle A*, a node can take the parent of its parent when there is line of sight between them,
+    /// so the solution is a short list of waypoints joined by straight lines instead of a chain of grid moves.
+    /// The lines cost their length by the maximum cost of the nodes they cross
+    class ThetaStar : public AStar
+    {
+    public:
+        /**
+         * Create a board with the size, start, and goal position given
+         *
+         * @param size Size of the board
+         * @param start Start position of the board
+         * @param goal Goal position of the board
+         */
+        ThetaStar(const Coordinate& size, const Coordinate& start, const Coordinate& goal)
+        : ThetaStar(size, start, goal, "Theta*") {}
+        
+        virtual ~ThetaStar(){}
+        
+        void init(const Heuristic heuristic, const bool diagonals = true, const bool cutCorners = true) override
+        {
+            AStar::init(heuristic, diagonals, cutCorners);
+            
+            auto* start = m_board.getStartNode();
+            start->h = this->heuristic(start->position);
+        }
+        
+        bool nextStep() override
+        {
+            if (!m_openNodes.size()) return true;
+            
+            sortNodes(m_openNodes);
+            
+            auto* node = closeNode();
+            
+            setVertex(node);
+            
+            // The goal is checked once expanded, a node opened may still get a better parent
+            if (checkGoal(node->position)) return true;
+            
+            std::vector<Node*> neighbors;
+            m_board.getNeighbors(node, neighbors, m_movement);
+            PATHFINDING_METRIC(metrics.neighborChecks += neighbors.size());
+            
+            for (auto* neighbor : neighbors)
+            {
+                if (neighbor->closed) continue;
+                
+                updateVertex(node, neighbor);
+            }
+            
+            return false;
+        }
+        
+        /**
+         * Calculates the distance of the solution, made of straight lines between its waypoints
+         *
+         * @return Distance of the solution
+         */
+        const double getSolutionDistance() const override
+        {
+            double distance = 0.f;
+            
+            for (size_t i = 1; i < solution.size(); ++i)
+            {
+                distance += lineCost(solution[i], solution[i - 1], m_board.getLineCost(solution[i], solution[i - 1], m_cutCorners));
+            }
+            return distance;
+        }
+        
+    protected:
+        /**
+         * Create a board with the size, start, and goal position given, for algorithms derived from Theta*
+         *
+         * @param size Size of the board
+         * @param start Start position of the board
+         * @param goal Goal position of the board
+         * @param name Name of the algorithm
+         */
+        ThetaStar(const Coordinate& size, const Coordinate& start, const Coordinate& goal, std::string &&name)
+        : AStar(size, start, goal, std::move(name)) {}
+        
+        /**
+         * Fixes the parent of a node right before it is expanded, nothing to fix as the lines are checked when the nodes are updated
+         *
+         * @param node Node to be expanded
+         */
+        virtual void setVertex(Node*) {}
+        
+        /**
+         * Updates a neighbor of the node expanded, with the parent of the node if there is line of sight between them
+         *
+         * @param node Node expanded
+         * @param neighbor Neighbor of the node, not closed
+         */
+        virtual void updateVertex(Node* node, Node* neighbor)
+        {
+            auto* parent = static_cast<Node*>(node->parent);
+            const auto cost = parent ? m_board.getLineCost(parent->position, neighbor->position, m_cutCorners) : 0;
+            
+            if (cost)
+                setParent(neighbor, parent, parent->g + lineCost(parent->position, neighbor->position, cost));
+            else
+                setParent(neighbor, node, node->g + moveCost(node->position, neighbor->position));
+        }
+        
+        /**
+         * Sets the parent of a node if it is not opened yet, or if the path through it is better
+         *
+         * @param node Node to update
+         * @param parent Parent to set
+         * @param g Cost from the start to the node through the parent
+         */
+        void setParent(Node* node, Node* parent, const double g)
+        {
+            if (!node->opened)
+            {
+                node->g = g;
+                node->h = heuristic(node->position);
+                openNode(node, parent);
+            }
+            else if (g < node->g)
+            {
+                PATHFINDING_METRIC(++metrics.decreaseKeys);
+                markChanged(node->position, Change::Parent);
+                node->parent = parent;
+                node->g = g;
+            }
+        }
+        
+        /**
+         * Calculates the cost of a straight line. The lines along an axis or a diagonal cost the same as the moves of moveCost,
+         * so the costs of the lines and the moves compared by the search are consistent
+         *
+         * @param from First coordinate
+         * @param to Second coordinate
+         * @param cost Maximum cost of the nodes crossed by the line
+         * @return Cost of the line
+         */
+        inline double lineCost(const Coordinate& from, const Coordinate& to, const Cost cost) const
+        {
+            const auto dx = std::abs(to.first - from.first);
+            const auto dy = std::abs(to.second - from.second);
+            
+            if (!dx || !dy) return (dx + dy) * (double)cost;
+            if (dx == dy) return dx * (double)m_diagonalCost * cost;
+            return std::hypot(dx, dy) * cost;
+        }
+    };
+}
+
+#endif
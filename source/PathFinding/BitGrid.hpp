@@ -0,0 +1,190 @@
+#ifndef BIT_GRID_H
+#define BIT_GRID_H
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "Coordinate.hpp"
+
+
+namespace PathFinding
+{
+    /// Dense grid of bits, one per node. Every column starts on its own word, so columns can be written in parallel
+    class BitGrid
+    {
+    public:
+        /// Define the word type in which the bits are packed
+        typedef std::uint64_t Word;
+
+        /// Number of bits of each word
+        static const int WordBits = 64;
+
+    private:
+        /// Size of the grid by axis
+        Coordinate m_size{ 0, 0 };
+
+        /// Number of words of every column
+        size_t m_columnWords = 0;
+
+        /// Collection of all the words of the grid, column by column
+        std::vector<Word> m_words;
+
+    public:
+        BitGrid() {}
+
+        /**
+         * Create a grid with every bit unset
+         *
+         * @param size Size of the grid by axis
+         */
+        explicit BitGrid(const Coordinate& size)
+            : m_size(size), m_columnWords((size.second + WordBits - 1) / WordBits), m_words(size.first * m_columnWords, 0) {}
+
+        /**
+         * Returns the size of the grid by axis
+         *
+         * @return Size of the grid by axis
+         */
+        inline const Coordinate getSize() const { return m_size; }
+
+        /**
+         * Returns the number of words of every column
+         *
+         * @return Number of words of every column
+         */
+        inline const size_t getColumnWords() const { return m_columnWords; }
+
+        /**
+         * Returns the words of a column, the bits after the size of the column must be kept unset
+         *
+         * @param x Column of the grid
+         * @return Pointer to the first word of the column
+         */
+        inline Word* getColumn(const int x) { return m_words.data() + x * m_columnWords; }
+
+        inline const Word* getColumn(const int x) const { return m_words.data() + x * m_columnWords; }
+
+        /**
+         * Checks if the position is within the limits of the grid
+         *
+         * @return If the position is within the limits of the grid
+         */
+        inline const bool isValid(const Coordinate& c) const
+        {
+            return c.first >= 0 && c.first < m_size.first && c.second >= 0 && c.second < m_size.second;
+        }
+
+        /**
+         * Checks if the bit of a valid coordinate is set
+         *
+         * @param c Coordinate of the bit
+         * @return If the bit is set
+         */
+        inline const bool test(const Coordinate& c) const
+        {
+            return (getColumn(c.first)[c.second / WordBits] >> (c.second % WordBits)) & 1;
+        }
+
+        /**
+         * Sets or unsets the bit of a valid coordinate
+         *
+         * @param c Coordinate of the bit
+         * @param value Whether the bit is set or not
+         */
+        inline void set(const Coordinate& c, const bool value = true)
+        {
+            auto& word = getColumn(c.first)[c.second / WordBits];
+            const Word mask = Word(1) << (c.second % WordBits);
+            word = value ? word | mask : word & ~mask;
+        }
+
+        /**
+         * Unsets every bit
+         */
+        void clear()
+        {
+            std::fill(m_words.begin(), m_words.end(), 0);
+        }
+
+        /**
+         * Counts the bits set
+         *
+         * @return Number of bits set
+         */
+        size_t count() const
+        {
+            size_t n = 0;
+            for (auto word : m_words)
+            {
+                n += std::popcount(word);
+            }
+            return n;
+        }
+
+        /**
+         * Changes the size of the grid keeping the bits of the area shared by both sizes
+         *
+         * @param size New size of the grid by axis
+         */
+        void resize(const Coordinate& size)
+        {
+            if (size == m_size) return;
+
+            BitGrid resized(size);
+            const int columns = std::min(size.first, m_size.first);
+            const int rows = std::min(size.second, m_size.second);
+
+            for (int i = 0; i < columns; ++i)
+            {
+                std::copy(getColumn(i), getColumn(i) + (rows + WordBits - 1) / WordBits, resized.getColumn(i));
+
+                // Unset the bits after the rows kept
+                if (rows % WordBits)
+                {
+                    resized.getColumn(i)[rows / WordBits] &= (Word(1) << (rows % WordBits)) - 1;
+                }
+            }
+
+            *this = std::move(resized);
+        }
+
+        /**
+         * Calls the function given with the coordinate of every bit set, skipping the empty words
+         *
+         * @param function Function called with the coordinate of every bit set
+         */
+        template<class F>
+        void forEachSet(F&& function) const
+        {
+            for (int i = 0; i < m_size.first; ++i)
+            {
+                const auto* column = getColumn(i);
+                for (size_t w = 0; w < m_columnWords; ++w)
+                {
+                    for (auto word = column[w]; word; word &= word - 1)
+                    {
+                        function(Coordinate{ i, (int)(w * WordBits) + std::countr_zero(word) });
+                    }
+                }
+            }
+        }
+
+        BitGrid& operator|=(const BitGrid& grid)
+        {
+            if (grid.m_size == m_size)
+            {
+                std::transform(m_words.begin(), m_words.end(), grid.m_words.begin(), m_words.begin(), std::bit_or<Word>());
+            }
+            return *this;
+        }
+
+        inline bool operator==(const BitGrid& grid) const { return m_size == grid.m_size && m_words == grid.m_words; }
+
+        inline bool operator!=(const BitGrid& grid) const { return !(*this == grid); }
+    };
+}
+
+#endif
@@ -2,7 +2,12 @@
 #define BOARD_H
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
 #include <vector>
+#include "BitGrid.hpp"
+#include "Coordinate.hpp"
 
 
 namespace PathFinding
@@ -10,8 +15,11 @@ namespace PathFinding
     template<class T, class U>
     concept Derived = std::is_base_of<U, T>::value;
 
-    /// Define the coordinate type
-    typedef std::pair<int, int> Coordinate;
+    /// Define the dense obstacle grid type, one bit per node
+    typedef BitGrid ObstacleGrid;
+    
+    /// Define the traversal cost type, a multiplier applied to every move into a cell
+    typedef std::uint8_t Cost;
 
     /// Define the node base struct
     struct NodeBase
@@ -22,12 +30,12 @@ namespace PathFinding
         /// Position of the Node
         Coordinate position{ 0, 0 };
         
-        /// Whether the node is an obstacle or not
-        bool obstacle = false;
-        
         /// Whether the node has been stored to be evaluated or not
         bool opened = false;
         
+        /// Whether the node has been evaluated or not
+        bool closed = false;
+        
         inline bool operator==(const NodeBase& node) { return position == node.position; }
         
         inline bool operator!=(const NodeBase& node) { return !(*this == node); }
@@ -36,15 +44,65 @@ namespace PathFinding
         {
             parent = nullptr;
             opened = false;
+            closed = false;
         }
         
         virtual void reset()
         {
             init();
-            obstacle = false;
         }
     };
     
+    /// Moves allowed between neighbor nodes
+    enum class Movement
+    {
+        /// Only to the 4 orthogonal neighbors
+        Orthogonal,
+
+        /// To the 8 neighbors, diagonally even passing next to an obstacle, if one of the contiguous nodes is free
+        Diagonal,
+
+        /// To the 8 neighbors, diagonally only if both contiguous nodes are free
+        DiagonalNoCornerCut
+    };
+
+    /**
+     * Returns the moves allowed by the flags of the algorithms
+     *
+     * @param diagonals The algorithm can use diagonal movements
+     * @param cutCorners The algorithm can cut corners when passing next to an obstacle
+     * @return Moves allowed between neighbor nodes
+     */
+    constexpr Movement GetMovement(const bool diagonals, const bool cutCorners)
+    {
+        return !diagonals ? Movement::Orthogonal : cutCorners ? Movement::Diagonal : Movement::DiagonalNoCornerCut;
+    }
+
+    /**
+     * Checks if a diagonal move is allowed from the accessibility of its contiguous nodes, resolved at compile time
+     *
+     * @param contiguous1 Whether the first contiguous node is accessible
+     * @param contiguous2 Whether the second contiguous node is accessible
+     * @return Whether the diagonal move is allowed
+     */
+    template <Movement M>
+    constexpr bool IsDiagonalAllowed(const bool contiguous1, const bool contiguous2)
+    {
+        if constexpr (M == Movement::Diagonal)
+            return contiguous1 || contiguous2;
+        else
+            return contiguous1 && contiguous2;
+    }
+
+    /// State of a node on the search
+    enum class NodeState
+    {
+        Free,
+        Obstacle,
+        Opened,
+        Closed
+    };
+    
     template <Derived<NodeBase>T>
     class Board
     {
@@ -56,6 +114,18 @@ namespace PathFinding
         /// Collection of all nodes of the Board
         std::vector<std::vector<T*>> m_nodes;
         
+        /// Whether every node of the Board is an obstacle or not
+        ObstacleGrid m_obstacles;
+        
+        /// Traversal cost of every node of the Board, stored contiguously by axis
+        std::vector<Cost> m_costs;
+        
+        /// Number of nodes of the Board with each cost, used to keep the minimum cost updated
+        std::array<size_t, 256> m_costCount{};
+        
+        /// Minimum traversal cost of the Board
+        Cost m_minCost = 1;
+        
     private:
         /// Whether the node has been stored to be evaluated or not
         const Coordinate m_size;
@@ -75,8 +145,10 @@ namespace PathFinding
          * @param goal Goal position of the board
          */
         Board(const Coordinate& size, const Coordinate& start, const Coordinate& goal)
-            : m_size(size), m_totalSize(size.first * size.second), m_nodes(size.first), m_start(start), m_goal(goal)
+            : m_size(size), m_totalSize(size.first * size.second), m_nodes(size.first), m_obstacles(size), m_costs(m_totalSize, 1), m_start(start), m_goal(goal)
         {
+            m_costCount[1] = m_totalSize;
+            
             for (size_t i = 0; i < m_size.first; ++i)
             {
                 // Create the rows
@@ -117,7 +189,7 @@ namespace PathFinding
         }
         
         /**
-         * Call reset on every node of the Board
+         * Call reset on every node of the Board and remove every obstacle
          */
         void reset()
         {
@@ -128,6 +200,8 @@ namespace PathFinding
                     m_nodes[i][j]->reset();
                 }
             }
+            
+            m_obstacles.clear();
         }
 
         auto& operator[](const size_t i) { return i < m_size.first ? m_nodes[i] : nullptr; }
@@ -151,6 +225,17 @@ namespace PathFinding
          */
         size_t getTotalSize() const { return m_totalSize; };
         
+        /**
+         * Get the approximate memory used by the board
+         *
+         * @return The approximate memory used by the board, in bytes
+         */
+        size_t getMemoryUsage() const
+        {
+            return m_totalSize * (sizeof(T) + sizeof(T*) + sizeof(Cost)) + m_size.first * sizeof(std::vector<T*>)
+                + m_size.first * m_obstacles.getColumnWords() * sizeof(BitGrid::Word);
+        }
+        
         /**
          * Returns the size of the board by axis
          *
@@ -229,7 +314,22 @@ namespace PathFinding
          * @return If the position is an obstacle
          */
         inline const bool isObstacle(const Coordinate& c) const {
-            return isValidNode(c) && operator[](c)->obstacle;
+            return isValidNode(c) && m_obstacles.test(c);
+        }
+        
+        /**
+         * Returns the state of the node at the coordinate given
+         *
+         * @param c Coordinate of the node
+         * @return The state of the node, free if the coordinate is not valid
+         */
+        inline const NodeState getState(const Coordinate& c) const
+        {
+            if (!isValidNode(c)) return NodeState::Free;
+            if (m_obstacles.test(c)) return NodeState::Obstacle;
+            
+            const auto* node = m_nodes[c.first][c.second];
+            return node->closed ? NodeState::Closed : node->opened ? NodeState::Opened : NodeState::Free;
         }
         
         /**
@@ -238,14 +338,147 @@ namespace PathFinding
          * @param c Coordinate in which the obstacle field is modified
          * @param obstacle Wether we set it to be an obstacle or not
          */
-        const void setObstacle(const Coordinate& c, const bool obstacle = true) const
+        void setObstacle(const Coordinate& c, const bool obstacle = true)
         {
             if (isValidNode(c) && c != m_start && c != m_goal)
             {
-                m_nodes[c.first][c.second]->obstacle = obstacle;
+                m_obstacles.set(c, obstacle);
             }
         }
         
+        /**
+         * Sets every node of the board as an obstacle or not from a grid of the same size, except the start and the goal
+         *
+         * @param obstacles Grid with a bit per node
+         */
+        void setObstacles(const ObstacleGrid& obstacles)
+        {
+            if (obstacles.getSize() != m_size) return;
+            
+            // Same layout, so it's a plain copy of the words
+            m_obstacles = obstacles;
+            
+            // The start and the goal can't be obstacles
+            if (isValidNode(m_start)) m_obstacles.set(m_start, false);
+            if (isValidNode(m_goal)) m_obstacles.set(m_goal, false);
+        }
+        
+        /**
+         * Returns the traversal cost of the node at the coordinate given
+         *
+         * @param c Coordinate of the node
+         * @return The traversal cost of the node, or the default cost if the coordinate is not valid
+         */
+        inline const Cost getCost(const Coordinate& c) const
+        {
+            return isValidNode(c) ? m_costs[c.first * m_size.second + c.second] : 1;
+        }
+        
+        /**
+         * Sets the traversal cost of the node at the coordinate given. Costs are terrain data, so they are kept on reset
+         *
+         * @param c Coordinate in which the cost is modified
+         * @param cost Cost of moving into the node, at least 1
+         */
+        void setCost(const Coordinate& c, const Cost cost = 1)
+        {
+            if (!isValidNode(c)) return;
+            
+            auto& current = m_costs[c.first * m_size.second + c.second];
+            const Cost next = std::max<Cost>(cost, 1);
+            
+            --m_costCount[current];
+            ++m_costCount[next];
+            current = next;
+            
+            // Only look for the new minimum if it could have changed
+            if (next < m_minCost)
+            {
+                m_minCost = next;
+            }
+            else if (!m_costCount[m_minCost])
+            {
+                while (!m_costCount[m_minCost]) ++m_minCost;
+            }
+        }
+        
+        /**
+         * Sets the traversal cost of every node of the board from a collection of the same size
+         *
+         * @param costs Collection with the cost of every node, stored contiguously by axis
+         */
+        void setCosts(const std::vector<Cost>& costs)
+        {
+            if (costs.size() != m_totalSize) return;
+            
+            m_costCount.fill(0);
+            for (size_t i = 0; i < m_totalSize; ++i)
+            {
+                m_costs[i] = std::max<Cost>(costs[i], 1);
+                ++m_costCount[m_costs[i]];
+            }
+            
+            for (m_minCost = 1; m_minCost < m_costCount.size() - 1 && !m_costCount[m_minCost]; ++m_minCost);
+        }
+        
+        /**
+         * Returns the minimum traversal cost of the board, so heuristics can be scaled by it and stay admissible
+         *
+         * @return The minimum traversal cost of the board
+         */
+        inline const Cost getMinCost() const { return m_minCost; }
+        
+        /**
+         * Walks the nodes crossed by the straight line between the centers of two nodes, checking them on the obstacle grid
+         * without touching the nodes. A line passing exactly through a corner crosses it like a diagonal move
+         *
+         * @param from First coordinate, valid
+         * @param to Second coordinate, valid
+         * @param cutCorners If the line can pass through a corner next to an obstacle
+         * @return The maximum cost of the nodes crossed after the first one, 0 if there is no line of sight
+         */
+        const Cost getLineCost(const Coordinate& from, const Coordinate& to, const bool cutCorners = true) const
+        {
+            int dx = std::abs(to.first - from.first), dy = std::abs(to.second - from.second);
+            const int sx = to.first > from.first ? 1 : -1, sy = to.second > from.second ? 1 : -1;
+            
+            Coordinate c = from;
+            int error = dx - dy;
+            dx *= 2;
+            dy *= 2;
+            
+            Cost cost = 0;
+            for (int n = dx / 2 + dy / 2; n > 0;)
+            {
+                if (error > 0)
+                {
+                    c.first += sx;
+                    error -= dy;
+                    --n;
+                }
+                else if (error < 0)
+                {
+                    c.second += sy;
+                    error += dx;
+                    --n;
+                }
+                else
+                {
+                    // Exactly through a corner, the same rule as a diagonal move
+                    const Coordinate next{ c.first + sx, c.second + sy };
+                    if (!isAccessible(c, next, cutCorners)) return 0;
+                    
+                    c = next;
+                    error += dx - dy;
+                    n -= 2;
+                }
+                
+                if (m_obstacles.test(c)) return 0;
+                cost = std::max(cost, m_costs[c.first * m_size.second + c.second]);
+            }
+            return cost;
+        }
+        
         /**
          * Adds the accessible neighbors to the collection given taking into account if diagonals can be used and/or can cut corners
          *
@@ -256,47 +489,37 @@ namespace PathFinding
          */
         void getNeighbors(T* node, std::vector<T*>& neighbors, const bool diagonals, const bool cutCorners) const
         {
-            if (!diagonals)
-            {
-                neighbors.reserve(4);
-                getNeighborsWithoutDiagonals(node, neighbors);
-            }
-            else
-            {
-                neighbors.reserve(8);
-                getNeighborsWithDiagonals(node, neighbors, cutCorners);
-            }
+            getNeighbors(node, neighbors, GetMovement(diagonals, cutCorners));
         }
-
-    protected:
+        
         /**
-         * Get the neighbors of the given node given this order:
-         *
-         *      Order:
-         *  +---+---+---+
-         *  |   | 1 |   |
-         *  +---+---+---+
-         *  | 4 |   | 2 |
-         *  +---+---+---+
-         *  |   | 3 |   |
-         *  +---+---+---+
+         * Adds the accessible neighbors to the collection given with the moves allowed, choosing the neighbor generator of
+         * the moves once per call
          *
          * @param node Node from which the neighbors are returned
          * @param neighbors Reference to the collection of neighbors to which they are added
+         * @param movement Moves allowed between neighbor nodes
          */
-        void getNeighborsWithoutDiagonals(T* node, std::vector<T*>& neighbors) const
+        void getNeighbors(T* node, std::vector<T*>& neighbors, const Movement movement) const
         {
-            auto first = node->position.first;
-            auto second = node->position.second;
-            
-            addIfAccessible(node, {first, second - 1}, neighbors);  // North
-            addIfAccessible(node, {first + 1, second}, neighbors);  // East
-            addIfAccessible(node, {first, second + 1}, neighbors);  // South
-            addIfAccessible(node, {first - 1, second}, neighbors);  // West
+            switch (movement)
+            {
+                case Movement::Orthogonal:
+                    getNeighbors<Movement::Orthogonal>(node, neighbors);
+                    break;
+                    
+                case Movement::Diagonal:
+                    getNeighbors<Movement::Diagonal>(node, neighbors);
+                    break;
+                    
+                case Movement::DiagonalNoCornerCut:
+                    getNeighbors<Movement::DiagonalNoCornerCut>(node, neighbors);
+                    break;
+            }
         }
         
         /**
-         * Get the neighbors including diagonals given this order:
+         * Adds the accessible neighbors to the collection given with the moves allowed at compile time, given this order:
          *
          *      Order:
          *  +---+---+---+
@@ -307,40 +530,49 @@ namespace PathFinding
          *  | 8 | 3 | 7 |
          *  +---+---+---+
          *
+         * The obstacles of the orthogonal neighbors are checked once and reused for the corners of the diagonal ones
+         *
          * @param node Node from which the neighbors are returned
          * @param neighbors Reference to the collection of neighbors to which they are added
-         * @param cutCorners If neighbors to which we have to cut corners are also added to the collection
          */
-        void getNeighborsWithDiagonals(T* node, std::vector<T*>& neighbors, const bool cutCorners) const
+        template <Movement M>
+        void getNeighbors(T* node, std::vector<T*>& neighbors) const
         {
-            getNeighborsWithoutDiagonals(node, neighbors);
+            neighbors.reserve(M == Movement::Orthogonal ? 4 : 8);
             
-            auto first = node->position.first;
-            auto second = node->position.second;
+            const auto& from = node->position;
             
-            addIfAccessible(node, {first - 1, second - 1}, neighbors, cutCorners);  // North West
-            addIfAccessible(node, {first + 1, second - 1}, neighbors, cutCorners);  // North East
-            addIfAccessible(node, {first + 1, second + 1}, neighbors, cutCorners);  // South East
-            addIfAccessible(node, {first - 1, second + 1}, neighbors, cutCorners);  // South West
-        }
-        
-    private:
-        /**
-         * Sets the node at the coordinate given as an obstacle or not
-         *
-         * @param from First node
-         * @param toPosition Second coordinate
-         * @param neighbors Reference to the collection of neighbors to which they are added
-         * @param cutCorners If neighbors to which we have to cut corners are also added to the collection
-         */
-        void addIfAccessible(T* from, const Coordinate& toPosition, std::vector<T*>& neighbors, const bool cutCorners = true) const
-        {
-            if (isValidNode(toPosition) && isAccessible(from->position, toPosition, cutCorners))
+            // Whether every orthogonal neighbor is accessible, to check the corners of the diagonal ones
+            bool accessible[4];
+            for (size_t i = 0; i < 4; ++i)
             {
-               neighbors.emplace_back(m_nodes[toPosition.first][toPosition.second]);
+                const Coordinate to{ from.first + m_directions[i].first, from.second + m_directions[i].second };
+                
+                accessible[i] = isValidNode(to) && !m_obstacles.test(to);
+                if (accessible[i]) neighbors.emplace_back(m_nodes[to.first][to.second]);
+            }
+            
+            if constexpr (M != Movement::Orthogonal)
+            {
+                for (size_t i = 4; i < 8; ++i)
+                {
+                    const Coordinate to{ from.first + m_directions[i].first, from.second + m_directions[i].second };
+                    if (!isValidNode(to) || m_obstacles.test(to)) continue;
+                    
+                    const bool contiguous1 = accessible[m_directions[i].second < 0 ? 0 : 2];
+                    const bool contiguous2 = accessible[m_directions[i].first > 0 ? 1 : 3];
+                    if (IsDiagonalAllowed<M>(contiguous1, contiguous2)) neighbors.emplace_back(m_nodes[to.first][to.second]);
+                }
             }
         }
         
+    private:
+        /// Offset of every direction, in the order of the neighbors
+        static constexpr std::array<Coordinate, 8> m_directions{{
+            { 0, -1 }, { 1, 0 }, { 0, 1 }, { -1, 0 },       // North, East, South, West
+            { -1, -1 }, { 1, -1 }, { 1, 1 }, { -1, 1 }      // North West, North East, South East, South West
+        }};
+        
         /**
          * Checks if the coordinates are not on the same x nor y axis, so, if they are neighbors, they are diagonally connected
          *
@@ -364,14 +596,14 @@ namespace PathFinding
         const bool isAccessible(const Coordinate& from, const Coordinate& to, const bool cutCorners = true) const
         {
             // Not accesible if any of the nodes is not valid, or the node to go to is an obstacle
-            if (!isValidNode(to) || !isValidNode(from) || m_nodes[to.first][to.second]->obstacle) return false;
+            if (!isValidNode(to) || !isValidNode(from) || m_obstacles.test(to)) return false;
             
             // If it is not a diagonal, it is accessible
             if (!isDiagonal(from, to)) return true;
 
             // If both contiguous are not obstacles, or only one is and we can cut corners, it is accesible
-            const bool contiguous1 = !m_nodes[from.first][to.second]->obstacle;
-            const bool contiguous2 = !m_nodes[to.first][from.second]->obstacle;
+            const bool contiguous1 = !m_obstacles.test({from.first, to.second});
+            const bool contiguous2 = !m_obstacles.test({to.first, from.second});
             return (contiguous1 && contiguous2) || (cutCorners && (contiguous1 || contiguous2));
         }
     };
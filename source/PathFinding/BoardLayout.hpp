@@ -0,0 +1,198 @@
+#ifndef BOARD_LAYOUT_H
+#define BOARD_LAYOUT_H
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include "Coordinate.hpp"
+
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
+
+namespace PathFinding
+{
+    /// Order in which the nodes of a board are stored on memory
+    enum class BoardLayout
+    {
+        /// Column by column, the nodes of a column are contiguous
+        Linear,
+
+        /// Tiles of 8x8 nodes stored one after another, the nodes of a tile are contiguous
+        Tiled,
+
+        /// Z-order curve, the nodes close on both axes are close on memory at every scale
+        Morton
+    };
+
+    /// Maps the coordinates of a board to the indexes of its nodes on memory and back, for the layout given.
+    /// Tiled and Morton layouts pad the board, up to a multiple of the tile side and up to powers of two
+    class LayoutIndexer
+    {
+    public:
+        /// Number of bits of the side of a tile
+        static const int TileBits = 3;
+
+        /// Number of nodes of the side of a tile
+        static const int TileSide = 1 << TileBits;
+
+    private:
+        BoardLayout m_layout;
+
+        /// Size of the board by axis
+        Coordinate m_size;
+
+        /// Number of tiles of every column of tiles
+        size_t m_columnTiles = 0;
+
+        /// Number of bits of each axis interleaved on the Morton layout, the rest of the bits of the longest axis go above
+        int m_mortonBits = 0;
+
+        /// Whether the longest axis of the Morton layout is the first one
+        bool m_mortonWide = false;
+
+        /// Number of indexes of the layout, including the padding
+        size_t m_capacity = 0;
+
+    public:
+        /**
+         * Creates the mapping of a board
+         *
+         * @param size Size of the board by axis
+         * @param layout Order of the nodes on memory
+         */
+        LayoutIndexer(const Coordinate& size, const BoardLayout layout = BoardLayout::Linear)
+            : m_layout(layout), m_size(size)
+        {
+            switch (m_layout)
+            {
+                case BoardLayout::Linear:
+                    m_capacity = (size_t)size.first * size.second;
+                    break;
+
+                case BoardLayout::Tiled:
+                    m_columnTiles = (size.second + TileSide - 1) / TileSide;
+                    m_capacity = (size_t)(size.first + TileSide - 1) / TileSide * m_columnTiles * TileSide * TileSide;
+                    break;
+
+                case BoardLayout::Morton:
+                {
+                    const auto width = std::bit_ceil((std::uint32_t)std::max(size.first, 1));
+                    const auto height = std::bit_ceil((std::uint32_t)std::max(size.second, 1));
+                    m_mortonBits = std::countr_zero(std::min(width, height));
+                    m_mortonWide = width > height;
+                    m_capacity = (size_t)width * height;
+                    break;
+                }
+            }
+        }
+
+        inline const BoardLayout getLayout() const { return m_layout; }
+
+        /**
+         * Returns the number of indexes of the layout, including the padding
+         *
+         * @return Number of indexes of the layout
+         */
+        inline const size_t getCapacity() const { return m_capacity; }
+
+        /**
+         * Returns the index of a valid coordinate
+         *
+         * @param c Coordinate of the node
+         * @return Index of the node on memory
+         */
+        inline size_t getIndex(const Coordinate& c) const
+        {
+            switch (m_layout)
+            {
+                case BoardLayout::Tiled:
+                {
+                    const size_t tile = (size_t)(c.first >> TileBits) * m_columnTiles + (c.second >> TileBits);
+                    return tile << (2 * TileBits) | (c.first & (TileSide - 1)) << TileBits | (c.second & (TileSide - 1));
+                }
+
+                case BoardLayout::Morton:
+                {
+                    const std::uint64_t mask = (std::uint64_t(1) << m_mortonBits) - 1;
+                    const std::uint64_t high = m_mortonWide ? (std::uint64_t)c.first >> m_mortonBits : (std::uint64_t)c.second >> m_mortonBits;
+                    return high << (2 * m_mortonBits) | Spread(c.first & mask) << 1 | Spread(c.second & mask);
+                }
+
+                default:
+                    return (size_t)c.first * m_size.second + c.second;
+            }
+        }
+
+        /**
+         * Returns the coordinate of an index, which is out of the board if it is padding
+         *
+         * @param index Index of the node on memory
+         * @return Coordinate of the node
+         */
+        inline Coordinate getPosition(const size_t index) const
+        {
+            switch (m_layout)
+            {
+                case BoardLayout::Tiled:
+                {
+                    const size_t tile = index >> (2 * TileBits);
+                    const int inTile = index & (TileSide * TileSide - 1);
+                    return { (int)(tile / m_columnTiles) * TileSide + (inTile >> TileBits),
+                             (int)(tile % m_columnTiles) * TileSide + (inTile & (TileSide - 1)) };
+                }
+
+                case BoardLayout::Morton:
+                {
+                    const std::uint64_t low = index & ((std::uint64_t(1) << (2 * m_mortonBits)) - 1);
+                    const int high = (int)(index >> (2 * m_mortonBits)) << m_mortonBits;
+                    const int x = (int)Compact(low >> 1), y = (int)Compact(low);
+                    return m_mortonWide ? Coordinate{ x | high, y } : Coordinate{ x, y | high };
+                }
+
+                default:
+                    return { (int)(index / m_size.second), (int)(index % m_size.second) };
+            }
+        }
+
+    private:
+        /**
+         * Spreads the bits of a value to the even bits of the result, a single instruction with BMI2
+         */
+        static inline std::uint64_t Spread(std::uint64_t value)
+        {
+#if defined(__BMI2__)
+            return _pdep_u64(value, 0x5555555555555555);
+#else
+            value = (value | value << 16) & 0x0000ffff0000ffff;
+            value = (value | value << 8) & 0x00ff00ff00ff00ff;
+            value = (value | value << 4) & 0x0f0f0f0f0f0f0f0f;
+            value = (value | value << 2) & 0x3333333333333333;
+            value = (value | value << 1) & 0x5555555555555555;
+            return value;
+#endif
+        }
+
+        /**
+         * Gathers the even bits of a value, the inverse of Spread
+         */
+        static inline std::uint64_t Compact(std::uint64_t value)
+        {
+#if defined(__BMI2__)
+            return _pext_u64(value, 0x5555555555555555);
+#else
+            value &= 0x5555555555555555;
+            value = (value | value >> 1) & 0x3333333333333333;
+            value = (value | value >> 2) & 0x0f0f0f0f0f0f0f0f;
+            value = (value | value >> 4) & 0x00ff00ff00ff00ff;
+            value = (value | value >> 8) & 0x0000ffff0000ffff;
+            value = (value | value >> 16) & 0x00000000ffffffff;
+            return value;
+#endif
+        }
+    };
+}
+
+#endif
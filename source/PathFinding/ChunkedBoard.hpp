@@ -0,0 +1,532 @@
+#ifndef CHUNKED_BOARD_H
+#define CHUNKED_BOARD_H
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "Board.hpp"
+
+
+namespace PathFinding
+{
+    /// Node without virtual functions nor position, 2 bytes. The position is derived from where it is stored and the
+    /// parent is the direction in which it is, in the same order as the neighbors of the board
+    struct ChunkedNode
+    {
+        /// Direction of a node without parent
+        static const std::uint8_t None = 8;
+
+        /// States of the node packed in its flags
+        enum Flag : std::uint8_t
+        {
+            Opened = 1,
+            Closed = 2
+        };
+
+        /// Direction of the previous node from which the shortest path reaches this node
+        std::uint8_t parent = None;
+
+        /// States of the node
+        std::uint8_t flags = 0;
+
+        inline bool is(const Flag flag) const { return flags & flag; }
+
+        inline void set(const Flag flag, const bool value = true) { flags = value ? flags | flag : flags & ~flag; }
+    };
+
+    /// Board split in square chunks that are only allocated when they are needed, for worlds too big to allocate whole
+    /// of which the searches only explore a small part. The nodes of a chunk are allocated the first time one of them is
+    /// touched and released together with a single call, the obstacles of the chunks without or full of obstacles are
+    /// stored as their state alone and the costs of the chunks with every cost of 1 are not stored
+    template <Derived<ChunkedNode>T>
+    class ChunkedBoard
+    {
+    public:
+        /// Number of bits of the side of a chunk
+        static constexpr int ChunkBits = 6;
+
+        /// Number of nodes of the side of a chunk
+        static constexpr int ChunkSide = 1 << ChunkBits;
+
+        /// Number of nodes of a chunk
+        static constexpr size_t ChunkNodes = ChunkSide * ChunkSide;
+
+        /// Offset of every direction, in the same order as the neighbors of Board
+        static constexpr std::array<Coordinate, 8> Directions{{
+            { 0, -1 }, { 1, 0 }, { 0, 1 }, { -1, 0 },       // North, East, South, West
+            { -1, -1 }, { 1, -1 }, { 1, 1 }, { -1, 1 }      // North West, North East, South East, South West
+        }};
+
+    private:
+        /// Define the word type in which the obstacles of a chunk are packed
+        typedef std::uint64_t Word;
+
+        /// Obstacles of a chunk, a word per column of the chunk
+        typedef std::array<Word, ChunkSide> ObstacleChunk;
+
+        /// Obstacles of the chunks stored as their state alone
+        enum class ChunkObstacles : std::uint8_t
+        {
+            Empty,
+            Full,
+            Mixed
+        };
+
+        /// Size of the board by axis
+        const Coordinate m_size;
+
+        /// Total size of the board
+        const size_t m_totalSize;
+
+        /// Position of the start node
+        const Coordinate m_start;
+
+        /// Position of the goal node
+        const Coordinate m_goal;
+
+        /// Number of chunks of every column of chunks
+        const size_t m_columnChunks;
+
+        /// Nodes of every chunk, null until one of them is touched
+        std::vector<std::unique_ptr<std::array<T, ChunkNodes>>> m_nodes;
+
+        /// Indexes of the chunks with nodes, to release them without going through every chunk
+        std::vector<size_t> m_nodeChunks;
+
+        /// State of the obstacles of every chunk
+        std::vector<ChunkObstacles> m_obstacleStates;
+
+        /// Obstacles of the chunks of mixed obstacles, a bit per node, null for the rest
+        std::vector<std::unique_ptr<ObstacleChunk>> m_obstacles;
+
+        /// Number of chunks of mixed obstacles
+        size_t m_obstacleChunks = 0;
+
+        /// Traversal cost of every node of every chunk, null for the chunks with every cost of 1
+        std::vector<std::unique_ptr<std::array<Cost, ChunkNodes>>> m_costs;
+
+        /// Number of chunks with costs
+        size_t m_costChunks = 0;
+
+        /// Number of nodes of the board with each cost, used to keep the minimum cost updated
+        std::array<size_t, 256> m_costCount{};
+
+        /// Minimum traversal cost of the board
+        Cost m_minCost = 1;
+
+    public:
+        /**
+         * Create a board with the size, start, and goal position given, without obstacles nor nodes allocated
+         *
+         * @param size Size of the board
+         * @param start Start position of the board
+         * @param goal Goal position of the board
+         */
+        ChunkedBoard(const Coordinate& size, const Coordinate& start, const Coordinate& goal)
+            : m_size(size), m_totalSize((size_t)size.first * size.second), m_start(start), m_goal(goal),
+              m_columnChunks((size.second + ChunkSide - 1) / ChunkSide)
+        {
+            const size_t chunks = (size.first + ChunkSide - 1) / ChunkSide * m_columnChunks;
+            m_nodes.resize(chunks);
+            m_obstacleStates.resize(chunks, ChunkObstacles::Empty);
+            m_obstacles.resize(chunks);
+            m_costs.resize(chunks);
+
+            m_costCount[1] = m_totalSize;
+        }
+
+        /**
+         * Releases the nodes of every chunk, keeping the obstacles
+         */
+        void init()
+        {
+            release();
+        }
+
+        /**
+         * Releases the nodes of every chunk and removes every obstacle
+         */
+        void reset()
+        {
+            release();
+
+            std::fill(m_obstacleStates.begin(), m_obstacleStates.end(), ChunkObstacles::Empty);
+            for (auto& chunk : m_obstacles) chunk.reset();
+            m_obstacleChunks = 0;
+        }
+
+        /**
+         * Releases the nodes of every chunk touched since the last release
+         */
+        void release()
+        {
+            for (const auto chunk : m_nodeChunks)
+            {
+                m_nodes[chunk].reset();
+            }
+            m_nodeChunks.clear();
+        }
+
+        /**
+         * Returns the node of a valid coordinate, allocating its chunk if none of its nodes has been touched yet
+         *
+         * @param c Coordinate of the node
+         * @return Reference to the node
+         */
+        inline T& operator[](const Coordinate& c)
+        {
+            const auto chunk = getChunk(c);
+            auto& nodes = m_nodes[chunk];
+            if (!nodes)
+            {
+                nodes = std::make_unique<std::array<T, ChunkNodes>>();
+                m_nodeChunks.push_back(chunk);
+            }
+            return (*nodes)[getChunkIndex(c)];
+        }
+
+        /**
+         * Returns the node of a valid coordinate without allocating its chunk
+         *
+         * @param c Coordinate of the node
+         * @return Pointer to the node, nullptr if none of the nodes of its chunk has been touched
+         */
+        inline const T* find(const Coordinate& c) const
+        {
+            const auto& nodes = m_nodes[getChunk(c)];
+            return nodes ? &(*nodes)[getChunkIndex(c)] : nullptr;
+        }
+
+        inline size_t getTotalSize() const { return m_totalSize; }
+
+        /**
+         * Returns the number of chunks with nodes allocated
+         *
+         * @return Number of chunks with nodes allocated
+         */
+        inline size_t getNodeChunks() const { return m_nodeChunks.size(); }
+
+        /**
+         * Get the approximate memory used by the board
+         *
+         * @return The approximate memory used by the board, in bytes
+         */
+        size_t getMemoryUsage() const
+        {
+            return m_nodes.size() * (sizeof(m_nodes[0]) + sizeof(m_obstacleStates[0]) + sizeof(m_obstacles[0]) + sizeof(m_costs[0]))
+                + m_nodeChunks.capacity() * sizeof(size_t) + m_nodeChunks.size() * sizeof(T) * ChunkNodes
+                + m_obstacleChunks * sizeof(ObstacleChunk) + m_costChunks * sizeof(Cost) * ChunkNodes;
+        }
+
+        inline const Coordinate getSize() const { return m_size; }
+
+        inline const Coordinate getStart() const { return m_start; }
+
+        inline const Coordinate getGoal() const { return m_goal; }
+
+        inline const bool isValidNode(const Coordinate& c) const
+        {
+            return c.first >= 0 && c.first < m_size.first && c.second >= 0 && c.second < m_size.second;
+        }
+
+        inline const bool isObstacle(const Coordinate& c) const
+        {
+            if (!isValidNode(c)) return false;
+
+            const auto chunk = getChunk(c);
+            switch (m_obstacleStates[chunk])
+            {
+                case ChunkObstacles::Empty: return false;
+                case ChunkObstacles::Full: return true;
+                default: return ((*m_obstacles[chunk])[c.first & (ChunkSide - 1)] >> (c.second & (ChunkSide - 1))) & 1;
+            }
+        }
+
+        /**
+         * Returns the state of the node at the coordinate given
+         *
+         * @param c Coordinate of the node
+         * @return The state of the node, free if the coordinate is not valid
+         */
+        inline const NodeState getState(const Coordinate& c) const
+        {
+            if (!isValidNode(c)) return NodeState::Free;
+            if (isObstacle(c)) return NodeState::Obstacle;
+
+            const auto* node = find(c);
+            return !node ? NodeState::Free : node->is(ChunkedNode::Closed) ? NodeState::Closed
+                : node->is(ChunkedNode::Opened) ? NodeState::Opened : NodeState::Free;
+        }
+
+        /**
+         * Sets the node at the coordinate given as an obstacle or not, except the start and the goal
+         *
+         * @param c Coordinate in which the obstacle field is modified
+         * @param obstacle Wether we set it to be an obstacle or not
+         */
+        void setObstacle(const Coordinate& c, const bool obstacle = true)
+        {
+            if (isValidNode(c) && c != m_start && c != m_goal)
+            {
+                storeObstacle(c, obstacle);
+            }
+        }
+
+        /**
+         * Sets every node of the board as an obstacle or not from a grid of the same size, except the start and the goal
+         *
+         * @param obstacles Grid with a bit per node
+         */
+        void setObstacles(const ObstacleGrid& obstacles)
+        {
+            if (obstacles.getSize() != m_size) return;
+
+            for (size_t chunk = 0; chunk < m_obstacles.size(); ++chunk)
+            {
+                if (!m_obstacles[chunk])
+                {
+                    m_obstacles[chunk] = std::make_unique<ObstacleChunk>();
+                    ++m_obstacleChunks;
+                }
+                m_obstacleStates[chunk] = ChunkObstacles::Mixed;
+
+                const Coordinate first = getChunkStart(chunk);
+                for (int i = 0; i < ChunkSide; ++i)
+                {
+                    Word word = 0;
+                    for (int j = 0; j < ChunkSide; ++j)
+                    {
+                        const Coordinate c{ first.first + i, first.second + j };
+                        if (isValidNode(c) && obstacles.test(c)) word |= Word(1) << j;
+                    }
+                    (*m_obstacles[chunk])[i] = word;
+                }
+
+                compress(chunk);
+            }
+
+            // The start and the goal can't be obstacles
+            if (isValidNode(m_start)) storeObstacle(m_start, false);
+            if (isValidNode(m_goal)) storeObstacle(m_goal, false);
+        }
+
+        inline const Cost getCost(const Coordinate& c) const
+        {
+            if (!isValidNode(c)) return 1;
+
+            const auto& costs = m_costs[getChunk(c)];
+            return costs ? (*costs)[getChunkIndex(c)] : 1;
+        }
+
+        /**
+         * Sets the traversal cost of the node at the coordinate given. Costs are terrain data, so they are kept on reset
+         *
+         * @param c Coordinate in which the cost is modified
+         * @param cost Cost of moving into the node, at least 1
+         */
+        void setCost(const Coordinate& c, const Cost cost = 1)
+        {
+            if (!isValidNode(c)) return;
+
+            const Cost next = std::max<Cost>(cost, 1);
+            auto& costs = m_costs[getChunk(c)];
+            if (!costs)
+            {
+                if (next == 1) return;
+
+                costs = std::make_unique<std::array<Cost, ChunkNodes>>();
+                costs->fill(1);
+                ++m_costChunks;
+            }
+
+            auto& current = (*costs)[getChunkIndex(c)];
+
+            --m_costCount[current];
+            ++m_costCount[next];
+            current = next;
+
+            // Only look for the new minimum if it could have changed
+            if (next < m_minCost)
+            {
+                m_minCost = next;
+            }
+            else if (!m_costCount[m_minCost])
+            {
+                while (!m_costCount[m_minCost]) ++m_minCost;
+            }
+        }
+
+        /**
+         * Sets the traversal cost of every node of the board from a collection of the same size
+         *
+         * @param costs Collection with the cost of every node, stored contiguously by axis
+         */
+        void setCosts(const std::vector<Cost>& costs)
+        {
+            if (costs.size() != m_totalSize) return;
+
+            m_costCount.fill(0);
+            m_costChunks = 0;
+            for (size_t chunk = 0; chunk < m_costs.size(); ++chunk)
+            {
+                m_costs[chunk].reset();
+
+                const Coordinate first = getChunkStart(chunk);
+                for (int i = first.first; i < std::min(first.first + ChunkSide, m_size.first); ++i)
+                {
+                    for (int j = first.second; j < std::min(first.second + ChunkSide, m_size.second); ++j)
+                    {
+                        const Cost cost = std::max<Cost>(costs[(size_t)i * m_size.second + j], 1);
+                        ++m_costCount[cost];
+                        if (cost == 1) continue;
+
+                        // Only the chunks with a cost other than 1 are stored
+                        if (!m_costs[chunk])
+                        {
+                            m_costs[chunk] = std::make_unique<std::array<Cost, ChunkNodes>>();
+                            m_costs[chunk]->fill(1);
+                            ++m_costChunks;
+                        }
+                        (*m_costs[chunk])[getChunkIndex({ i, j })] = cost;
+                    }
+                }
+            }
+
+            for (m_minCost = 1; m_minCost < m_costCount.size() - 1 && !m_costCount[m_minCost]; ++m_minCost);
+        }
+
+        inline const Cost getMinCost() const { return m_minCost; }
+
+        /**
+         * Adds the accessible neighbors with the moves allowed, choosing the neighbor generator of the moves once per call
+         *
+         * @param c Coordinate of the node from which the neighbors are returned
+         * @param neighbors Reference to the collection of neighbors to which they are added
+         * @param movement Moves allowed between neighbor nodes
+         */
+        void getNeighbors(const Coordinate& c, std::vector<Coordinate>& neighbors, const Movement movement) const
+        {
+            switch (movement)
+            {
+                case Movement::Orthogonal:
+                    return getNeighbors<Movement::Orthogonal>(c, neighbors);
+
+                case Movement::Diagonal:
+                    return getNeighbors<Movement::Diagonal>(c, neighbors);
+
+                case Movement::DiagonalNoCornerCut:
+                    return getNeighbors<Movement::DiagonalNoCornerCut>(c, neighbors);
+            }
+        }
+
+        /**
+         * Adds the accessible neighbors to the collection given, in the same order as the neighbors of Board. Only the
+         * obstacles are checked, so no chunk of nodes is allocated
+         *
+         * @param c Coordinate of the node from which the neighbors are returned
+         * @param neighbors Reference to the collection of neighbors to which they are added
+         */
+        template <Movement M>
+        void getNeighbors(const Coordinate& c, std::vector<Coordinate>& neighbors) const
+        {
+            // Whether every orthogonal neighbor is accessible, to check the corners of the diagonal ones
+            bool accessible[4];
+            for (size_t i = 0; i < 4; ++i)
+            {
+                const Coordinate to{ c.first + Directions[i].first, c.second + Directions[i].second };
+
+                accessible[i] = isValidNode(to) && !isObstacle(to);
+                if (accessible[i]) neighbors.push_back(to);
+            }
+
+            if constexpr (M == Movement::Orthogonal) return;
+
+            for (size_t i = 4; i < 8; ++i)
+            {
+                const Coordinate to{ c.first + Directions[i].first, c.second + Directions[i].second };
+                if (!isValidNode(to) || isObstacle(to)) continue;
+
+                const bool contiguous1 = accessible[Directions[i].second < 0 ? 0 : 2];
+                const bool contiguous2 = accessible[Directions[i].first > 0 ? 1 : 3];
+                if (!IsDiagonalAllowed<M>(contiguous1, contiguous2)) continue;
+
+                neighbors.push_back(to);
+            }
+        }
+
+    private:
+        inline size_t getChunk(const Coordinate& c) const
+        {
+            return (size_t)(c.first >> ChunkBits) * m_columnChunks + (c.second >> ChunkBits);
+        }
+
+        inline size_t getChunkIndex(const Coordinate& c) const
+        {
+            return (size_t)(c.first & (ChunkSide - 1)) << ChunkBits | (c.second & (ChunkSide - 1));
+        }
+
+        inline Coordinate getChunkStart(const size_t chunk) const
+        {
+            return { (int)(chunk / m_columnChunks) << ChunkBits, (int)(chunk % m_columnChunks) << ChunkBits };
+        }
+
+        /**
+         * Sets a valid node as an obstacle or not, storing the obstacles of its chunk in bits if they become mixed
+         *
+         * @param c Coordinate of the node
+         * @param obstacle Wether we set it to be an obstacle or not
+         */
+        void storeObstacle(const Coordinate& c, const bool obstacle)
+        {
+            if (isObstacle(c) == obstacle) return;
+
+            const auto chunk = getChunk(c);
+            auto& state = m_obstacleStates[chunk];
+            if (state != ChunkObstacles::Mixed)
+            {
+                m_obstacles[chunk] = std::make_unique<ObstacleChunk>();
+                m_obstacles[chunk]->fill(state == ChunkObstacles::Full ? ~Word(0) : 0);
+                state = ChunkObstacles::Mixed;
+                ++m_obstacleChunks;
+            }
+
+            auto& word = (*m_obstacles[chunk])[c.first & (ChunkSide - 1)];
+            const Word mask = Word(1) << (c.second & (ChunkSide - 1));
+            word = obstacle ? word | mask : word & ~mask;
+
+            compress(chunk);
+        }
+
+        /**
+         * Stores the obstacles of a chunk as its state alone if it is empty or full, ignoring the nodes out of the board
+         *
+         * @param chunk Index of the chunk with mixed obstacles
+         */
+        void compress(const size_t chunk)
+        {
+            const auto& words = *m_obstacles[chunk];
+            const auto first = getChunkStart(chunk);
+            const int columns = std::min(ChunkSide, m_size.first - first.first);
+            const int rows = std::min(ChunkSide, m_size.second - first.second);
+            const Word rowMask = rows == ChunkSide ? ~Word(0) : (Word(1) << rows) - 1;
+
+            bool empty = true, full = true;
+            for (int i = 0; i < columns && (empty || full); ++i)
+            {
+                empty &= !(words[i] & rowMask);
+                full &= (words[i] & rowMask) == rowMask;
+            }
+
+            if (!empty && !full) return;
+
+            m_obstacleStates[chunk] = empty ? ChunkObstacles::Empty : ChunkObstacles::Full;
+            m_obstacles[chunk].reset();
+            --m_obstacleChunks;
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,240 @@
+#ifndef COMPACT_PATH_H
+#define COMPACT_PATH_H
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <iostream>
+#include <iterator>
+#include <vector>
+#include "Coordinate.hpp"
+
+
+namespace PathFinding
+{
+    /// Path between neighbor coordinates, stored as its first coordinate and the direction of every step in 3 bits,
+    /// so it uses about 20 times less memory than a collection of coordinates. The coordinates are walked on demand
+    class CompactPath
+    {
+    public:
+        /// Define the word type in which the steps are packed
+        typedef std::uint64_t Word;
+
+        /// Number of bits of every step
+        static const int StepBits = 3;
+
+        /// Number of steps of every word
+        static const int WordSteps = 64 / StepBits;
+
+    private:
+        /// Offset of every direction, in the same order as the neighbors of the board
+        static constexpr std::array<Coordinate, 8> m_directions{{
+            { 0, -1 }, { 1, 0 }, { 0, 1 }, { -1, 0 },       // North, East, South, West
+            { -1, -1 }, { 1, -1 }, { 1, 1 }, { -1, 1 }      // North West, North East, South East, South West
+        }};
+
+        /// First coordinate of the path
+        Coordinate m_start{ 0, 0 };
+
+        /// Number of steps of the path, one less than its coordinates
+        size_t m_steps = 0;
+
+        /// Whether the path has any coordinate or not
+        bool m_empty = true;
+
+        /// Collection of the directions of the steps, packed in words
+        std::vector<Word> m_words;
+
+    public:
+        /// Walks the coordinates of the path from the first one
+        class Iterator
+        {
+            const CompactPath* m_path = nullptr;
+            size_t m_step = 0;
+            Coordinate m_position{ 0, 0 };
+
+        public:
+            typedef std::forward_iterator_tag   iterator_category;
+            typedef Coordinate                  value_type;
+            typedef std::ptrdiff_t              difference_type;
+            typedef const Coordinate*           pointer;
+            typedef const Coordinate&           reference;
+
+            Iterator() {}
+
+            Iterator(const CompactPath* path, const size_t step, const Coordinate& position)
+                : m_path(path), m_step(step), m_position(position) {}
+
+            inline reference operator*() const { return m_position; }
+
+            inline pointer operator->() const { return &m_position; }
+
+            Iterator& operator++()
+            {
+                if (m_step < m_path->m_steps)
+                {
+                    const auto& offset = m_directions[m_path->getDirection(m_step)];
+                    m_position = { m_position.first + offset.first, m_position.second + offset.second };
+                }
+                ++m_step;
+                return *this;
+            }
+
+            Iterator operator++(int)
+            {
+                auto it = *this;
+                ++*this;
+                return it;
+            }
+
+            inline bool operator==(const Iterator& it) const { return m_step == it.m_step; }
+
+            inline bool operator!=(const Iterator& it) const { return !(*this == it); }
+        };
+
+        CompactPath() {}
+
+        /**
+         * Clears the path and makes room for the steps given, so the path is built without reallocations
+         *
+         * @param start First coordinate of the path
+         * @param steps Number of steps of the path
+         */
+        void assign(const Coordinate& start, const size_t steps)
+        {
+            m_start = start;
+            m_steps = steps;
+            m_empty = false;
+            m_words.assign((steps + WordSteps - 1) / WordSteps, 0);
+        }
+
+        /**
+         * Removes every coordinate of the path
+         */
+        void clear()
+        {
+            m_steps = 0;
+            m_empty = true;
+            m_words.clear();
+        }
+
+        /**
+         * Sets the direction of a step of a path already assigned, in any order
+         *
+         * @param step Index of the step, the one from the first coordinate is 0
+         * @param from Coordinate moved from
+         * @param to Coordinate moved into
+         * @return Whether the coordinates are neighbors, otherwise the step can't be stored
+         */
+        bool setStep(const size_t step, const Coordinate& from, const Coordinate& to)
+        {
+            const int direction = GetDirection(from, to);
+            if (direction < 0) return false;
+
+            m_words[step / WordSteps] |= (Word)direction << (step % WordSteps * StepBits);
+            return true;
+        }
+
+        /**
+         * Returns the direction of the move between two coordinates
+         *
+         * @param from Coordinate moved from
+         * @param to Coordinate moved into
+         * @return Index of the direction, -1 if the coordinates are not neighbors
+         */
+        static int GetDirection(const Coordinate& from, const Coordinate& to)
+        {
+            const Coordinate offset{ to.first - from.first, to.second - from.second };
+            for (int i = 0; i < (int)m_directions.size(); ++i)
+            {
+                if (m_directions[i] == offset) return i;
+            }
+            return -1;
+        }
+
+        /**
+         * Returns the number of coordinates of the path
+         *
+         * @return Number of coordinates of the path
+         */
+        inline const size_t size() const { return m_empty ? 0 : m_steps + 1; }
+
+        inline const bool empty() const { return m_empty; }
+
+        /**
+         * Returns the first coordinate of the path, only valid if it is not empty
+         *
+         * @return First coordinate of the path
+         */
+        inline const Coordinate getStart() const { return m_start; }
+
+        inline Iterator begin() const { return Iterator(this, 0, m_start); }
+
+        inline Iterator end() const { return Iterator(this, size(), m_start); }
+
+        /**
+         * Returns the coordinates of the path, from the first one
+         *
+         * @return Collection of coordinates of the path
+         */
+        std::vector<Coordinate> toVector() const
+        {
+            return std::vector<Coordinate>(begin(), end());
+        }
+
+        /**
+         * Returns the memory used by the path
+         *
+         * @return Bytes used by the path
+         */
+        size_t getMemoryUsage() const
+        {
+            return sizeof(*this) + m_words.capacity() * sizeof(Word);
+        }
+
+        /**
+         * Writes the path in binary: the first coordinate and the number of coordinates as 32 bits integers, and the words
+         *
+         * @param os Stream to which the path is written
+         */
+        void write(std::ostream& os) const
+        {
+            const std::int32_t header[3]{ m_start.first, m_start.second, (std::int32_t)size() };
+            os.write((const char*)header, sizeof(header));
+            os.write((const char*)m_words.data(), m_words.size() * sizeof(Word));
+        }
+
+        /**
+         * Reads a path written in binary
+         *
+         * @param is Stream from which the path is read
+         * @return Whether the path could be read or not
+         */
+        bool read(std::istream& is)
+        {
+            std::int32_t header[3];
+            if (!is.read((char*)header, sizeof(header)) || header[2] < 0) return false;
+
+            clear();
+            if (!header[2]) return true;
+
+            assign({ header[0], header[1] }, header[2] - 1);
+            return (bool)is.read((char*)m_words.data(), m_words.size() * sizeof(Word));
+        }
+
+        inline bool operator==(const CompactPath& path) const
+        {
+            return size() == path.size() && (m_empty || (m_start == path.m_start && m_words == path.m_words));
+        }
+
+        inline bool operator!=(const CompactPath& path) const { return !(*this == path); }
+
+    private:
+        inline int getDirection(const size_t step) const
+        {
+            return (m_words[step / WordSteps] >> (step % WordSteps * StepBits)) & 7;
+        }
+    };
+}
+
+#endif
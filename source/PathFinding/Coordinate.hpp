@@ -0,0 +1,14 @@
+#ifndef COORDINATE_H
+#define COORDINATE_H
+#pragma once
+
+#include <utility>
+
+
+namespace PathFinding
+{
+    /// Define the coordinate type
+    typedef std::pair<int, int> Coordinate;
+}
+
+#endif
@@ -0,0 +1,309 @@
+#ifndef FIXED_BOARD_H
+#define FIXED_BOARD_H
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include "SlimBoard.hpp"
+
+
+namespace PathFinding
+{
+    /// Board of slim nodes with its size known at compile time, for tiny boards searched millions of times. The nodes and
+    /// costs are stored in arrays inside of the board, so it needs no allocation at all, and the offsets of the neighbors
+    /// are constant, so the loops over them can be fully unrolled. The nodes are stored column by column
+    template <Derived<SlimNode>T, int Width, int Height>
+    class FixedBoard
+    {
+        static_assert(Width > 0 && Height > 0, "The board needs at least a node");
+        static_assert((std::uint64_t)Width * Height < SlimNode::None, "The indexes of the nodes must fit in 32 bits");
+
+    public:
+        /// Total size of the board
+        static constexpr std::uint32_t TotalSize = Width * Height;
+
+    private:
+        /// Offset of every direction, in the same order as the neighbors of Board
+        static constexpr std::array<Coordinate, 8> m_directions{{
+            { 0, -1 }, { 1, 0 }, { 0, 1 }, { -1, 0 },       // North, East, South, West
+            { -1, -1 }, { 1, -1 }, { 1, 1 }, { -1, 1 }      // North West, North East, South East, South West
+        }};
+
+        /// Offset of the index of the neighbor on every direction
+        static constexpr std::array<int, 8> m_offsets{{
+            -1, Height, 1, -Height,
+            -Height - 1, Height - 1, Height + 1, -Height + 1
+        }};
+
+        /// Position of the start node
+        const Coordinate m_start;
+
+        /// Position of the goal node
+        const Coordinate m_goal;
+
+        /// Collection of all nodes of the board
+        std::array<T, TotalSize> m_nodes{};
+
+        /// Traversal cost of every node of the board, stored contiguously by axis
+        std::array<Cost, TotalSize> m_costs;
+
+        /// Number of nodes of the board with each cost, used to keep the minimum cost updated
+        std::array<std::uint32_t, 256> m_costCount{};
+
+        /// Minimum traversal cost of the board
+        Cost m_minCost = 1;
+
+    public:
+        /**
+         * Create a board with the start and goal position given
+         *
+         * @param start Start position of the board
+         * @param goal Goal position of the board
+         */
+        FixedBoard(const Coordinate& start, const Coordinate& goal)
+            : m_start(start), m_goal(goal)
+        {
+            m_costs.fill(1);
+            m_costCount[1] = TotalSize;
+        }
+
+        /**
+         * Resets every node of the board, keeping the obstacles
+         */
+        void init()
+        {
+            for (auto& node : m_nodes)
+            {
+                const bool obstacle = node.is(SlimNode::Obstacle);
+                node = T();
+                node.set(SlimNode::Obstacle, obstacle);
+            }
+        }
+
+        /**
+         * Resets every node of the board and removes every obstacle
+         */
+        void reset()
+        {
+            m_nodes.fill(T());
+        }
+
+        inline T& operator[](const std::uint32_t index) { return m_nodes[index]; }
+
+        inline const T& operator[](const std::uint32_t index) const { return m_nodes[index]; }
+
+        /**
+         * Returns the index of a valid coordinate
+         *
+         * @param c Coordinate of the node
+         * @return Index of the node
+         */
+        static constexpr std::uint32_t GetIndex(const Coordinate& c) { return c.first * Height + c.second; }
+
+        /**
+         * Returns the coordinate of a node from its index
+         *
+         * @param index Index of the node
+         * @return Coordinate of the node
+         */
+        static constexpr Coordinate GetPosition(const std::uint32_t index) { return { (int)(index / Height), (int)(index % Height) }; }
+
+        static constexpr bool IsValidNode(const Coordinate& c)
+        {
+            return c.first >= 0 && c.first < Width && c.second >= 0 && c.second < Height;
+        }
+
+        inline size_t getTotalSize() const { return TotalSize; }
+
+        /**
+         * Get the memory used by the board, all of it inside of the board
+         *
+         * @return The memory used by the board, in bytes
+         */
+        size_t getMemoryUsage() const { return sizeof(*this); }
+
+        inline const Coordinate getSize() const { return { Width, Height }; }
+
+        inline const Coordinate getStart() const { return m_start; }
+
+        inline const Coordinate getGoal() const { return m_goal; }
+
+        inline const bool isObstacle(const Coordinate& c) const
+        {
+            return IsValidNode(c) && m_nodes[GetIndex(c)].is(SlimNode::Obstacle);
+        }
+
+        /**
+         * Returns the state of the node at the coordinate given
+         *
+         * @param c Coordinate of the node
+         * @return The state of the node, free if the coordinate is not valid
+         */
+        inline const NodeState getState(const Coordinate& c) const
+        {
+            if (!IsValidNode(c)) return NodeState::Free;
+
+            const auto& node = m_nodes[GetIndex(c)];
+            return node.is(SlimNode::Obstacle) ? NodeState::Obstacle : node.is(SlimNode::Closed) ? NodeState::Closed
+                : node.is(SlimNode::Opened) ? NodeState::Opened : NodeState::Free;
+        }
+
+        /**
+         * Sets the node at the coordinate given as an obstacle or not, except the start and the goal
+         *
+         * @param c Coordinate in which the obstacle field is modified
+         * @param obstacle Wether we set it to be an obstacle or not
+         */
+        void setObstacle(const Coordinate& c, const bool obstacle = true)
+        {
+            if (IsValidNode(c) && c != m_start && c != m_goal)
+            {
+                m_nodes[GetIndex(c)].set(SlimNode::Obstacle, obstacle);
+            }
+        }
+
+        /**
+         * Sets every node of the board as an obstacle or not from a grid of the same size, except the start and the goal
+         *
+         * @param obstacles Grid with a bit per node
+         */
+        void setObstacles(const ObstacleGrid& obstacles)
+        {
+            if (obstacles.getSize() != getSize()) return;
+
+            for (std::uint32_t i = 0; i < TotalSize; ++i)
+            {
+                m_nodes[i].set(SlimNode::Obstacle, obstacles.test(GetPosition(i)));
+            }
+
+            // The start and the goal can't be obstacles
+            if (IsValidNode(m_start)) m_nodes[GetIndex(m_start)].set(SlimNode::Obstacle, false);
+            if (IsValidNode(m_goal)) m_nodes[GetIndex(m_goal)].set(SlimNode::Obstacle, false);
+        }
+
+        inline const Cost getCost(const Coordinate& c) const
+        {
+            return IsValidNode(c) ? m_costs[GetIndex(c)] : 1;
+        }
+
+        inline const Cost getCost(const std::uint32_t index) const { return m_costs[index]; }
+
+        /**
+         * Sets the traversal cost of the node at the coordinate given. Costs are terrain data, so they are kept on reset
+         *
+         * @param c Coordinate in which the cost is modified
+         * @param cost Cost of moving into the node, at least 1
+         */
+        void setCost(const Coordinate& c, const Cost cost = 1)
+        {
+            if (!IsValidNode(c)) return;
+
+            auto& current = m_costs[GetIndex(c)];
+            const Cost next = std::max<Cost>(cost, 1);
+
+            --m_costCount[current];
+            ++m_costCount[next];
+            current = next;
+
+            // Only look for the new minimum if it could have changed
+            if (next < m_minCost)
+            {
+                m_minCost = next;
+            }
+            else if (!m_costCount[m_minCost])
+            {
+                while (!m_costCount[m_minCost]) ++m_minCost;
+            }
+        }
+
+        /**
+         * Sets the traversal cost of every node of the board from a collection of the same size
+         *
+         * @param costs Collection with the cost of every node, stored contiguously by axis
+         */
+        void setCosts(const std::vector<Cost>& costs)
+        {
+            if (costs.size() != TotalSize) return;
+
+            m_costCount.fill(0);
+            for (std::uint32_t i = 0; i < TotalSize; ++i)
+            {
+                m_costs[i] = std::max<Cost>(costs[i], 1);
+                ++m_costCount[m_costs[i]];
+            }
+
+            for (m_minCost = 1; m_minCost < m_costCount.size() - 1 && !m_costCount[m_minCost]; ++m_minCost);
+        }
+
+        inline const Cost getMinCost() const { return m_minCost; }
+
+        /**
+         * Adds the accessible neighbors with the moves allowed, choosing the neighbor generator of the moves once per call
+         *
+         * @param index Index of the node from which the neighbors are returned
+         * @param neighbors Reference to the array in which the neighbors are stored
+         * @param movement Moves allowed between neighbor nodes
+         * @return Number of neighbors stored
+         */
+        size_t getNeighbors(const std::uint32_t index, std::array<std::uint32_t, 8>& neighbors, const Movement movement) const
+        {
+            switch (movement)
+            {
+                case Movement::Orthogonal:
+                    return getNeighbors<Movement::Orthogonal>(index, neighbors);
+
+                case Movement::Diagonal:
+                    return getNeighbors<Movement::Diagonal>(index, neighbors);
+
+                case Movement::DiagonalNoCornerCut:
+                    return getNeighbors<Movement::DiagonalNoCornerCut>(index, neighbors);
+            }
+            return 0;
+        }
+
+        /**
+         * Stores the indexes of the accessible neighbors in the array given, in the same order as the neighbors of Board
+         *
+         * @param index Index of the node from which the neighbors are returned
+         * @param neighbors Reference to the array in which the neighbors are stored
+         * @return Number of neighbors stored
+         */
+        template <Movement M>
+        size_t getNeighbors(const std::uint32_t index, std::array<std::uint32_t, 8>& neighbors) const
+        {
+            const auto from = GetPosition(index);
+            size_t count = 0;
+
+            // Whether every orthogonal neighbor is accessible, to check the corners of the diagonal ones
+            bool accessible[4];
+            for (size_t i = 0; i < 4; ++i)
+            {
+                const Coordinate to{ from.first + m_directions[i].first, from.second + m_directions[i].second };
+                const auto toIndex = index + m_offsets[i];
+
+                accessible[i] = IsValidNode(to) && !m_nodes[toIndex].is(SlimNode::Obstacle);
+                if (accessible[i]) neighbors[count++] = toIndex;
+            }
+
+            if constexpr (M == Movement::Orthogonal) return count;
+
+            for (size_t i = 4; i < 8; ++i)
+            {
+                const Coordinate to{ from.first + m_directions[i].first, from.second + m_directions[i].second };
+                const auto toIndex = index + m_offsets[i];
+                if (!IsValidNode(to) || m_nodes[toIndex].is(SlimNode::Obstacle)) continue;
+
+                const bool contiguous1 = accessible[m_directions[i].second < 0 ? 0 : 2];
+                const bool contiguous2 = accessible[m_directions[i].first > 0 ? 1 : 3];
+                if (!IsDiagonalAllowed<M>(contiguous1, contiguous2)) continue;
+
+                neighbors[count++] = toIndex;
+            }
+
+            return count;
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,297 @@
+#ifndef OBSTACLE_GENERATOR_H
+#define OBSTACLE_GENERATOR_H
+#pragma once
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+#include "RandomGenerator.hpp"
+#include "../Board.hpp"
+
+
+namespace PathFinding
+{
+    /// Layout of the generated obstacles
+    enum class ObstaclePattern
+    {
+        Uniform,
+        Maze,
+        Rooms,
+        CityBlocks
+    };
+
+    /// Generates reproducible obstacles, the same seed always produces the same obstacles
+    class ObstacleGenerator
+    {
+    private:
+        /// Columns generated with the same random stream, so the result doesn't depend on the number of threads
+        static const size_t m_chunkColumns = 64;
+
+        /// Minimum number of nodes to generate them in parallel
+        static const size_t m_parallelNodes = 1 << 20;
+
+        /// Size of the side of the city blocks, without the street
+        static const int m_blockSize = 6;
+
+        /// Width of the streets between the city blocks
+        static const int m_streetWidth = 2;
+
+    public:
+        /**
+         * Generates the obstacles of a board with the pattern given
+         *
+         * @param pattern Layout of the obstacles
+         * @param size Size of the board
+         * @param seed Seed of the random generator
+         * @param density Probability of each node to be an obstacle on Uniform, fraction of the board left as walls on Rooms,
+         *                and probability of each block to be built on CityBlocks. Mazes don't use it
+         * @return Grid with a bit per node
+         */
+        static ObstacleGrid Generate(const ObstaclePattern pattern, const Coordinate& size, const std::uint64_t seed, const double density = 0.3)
+        {
+            ObstacleGrid grid(size);
+
+            switch (pattern)
+            {
+                case ObstaclePattern::Uniform:
+                    GenerateUniform(grid, size, seed, density);
+                    break;
+
+                case ObstaclePattern::Maze:
+                    GenerateMaze(grid, size, seed);
+                    break;
+
+                case ObstaclePattern::Rooms:
+                    GenerateRooms(grid, size, seed, density);
+                    break;
+
+                case ObstaclePattern::CityBlocks:
+                    GenerateCityBlocks(grid, size, seed, density);
+                    break;
+            }
+
+            return grid;
+        }
+
+    private:
+        /**
+         * Every node is an obstacle with the probability given
+         */
+        static void GenerateUniform(ObstacleGrid& grid, const Coordinate& size, const std::uint64_t seed, const double density)
+        {
+            // Compare against a threshold instead of converting every random number
+            const bool full = density >= 1.f;
+            const auto threshold = density <= 0.f || full ? 0 : (std::uint64_t)(density * 18446744073709551616.0);
+
+            ForEachChunk(size, seed, [&](const int first, const int last, RandomGenerator& random)
+            {
+                for (int i = first; i < last; ++i)
+                {
+                    FillColumn(grid, i, [&](const int) { return full || random.next() < threshold; });
+                }
+            });
+        }
+
+        /**
+         * Perfect maze carved with a recursive backtracker, the passages are on the odd coordinates
+         */
+        static void GenerateMaze(ObstacleGrid& grid, const Coordinate& size, const std::uint64_t seed)
+        {
+            Fill(grid);
+            if (size.first < 2 || size.second < 2) return;
+
+            RandomGenerator random(seed);
+            const Coordinate directions[4]{ {0, -2}, {2, 0}, {0, 2}, {-2, 0} };
+
+            // Iterative, so big mazes don't overflow the call stack
+            std::vector<Coordinate> stack{ {1, 1} };
+            grid.set(stack.back(), false);
+
+            while (stack.size())
+            {
+                const auto current = stack.back();
+
+                Coordinate next[4];
+                size_t n = 0;
+                for (const auto& d : directions)
+                {
+                    const Coordinate c{ current.first + d.first, current.second + d.second };
+                    if (c.first > 0 && c.first < size.first - 1 && c.second > 0 && c.second < size.second - 1 && grid.test(c))
+                    {
+                        next[n++] = c;
+                    }
+                }
+
+                if (!n)
+                {
+                    stack.pop_back();
+                    continue;
+                }
+
+                // Carve the chosen cell and the wall between both
+                const auto chosen = next[random.nextBelow((std::uint32_t)n)];
+                grid.set({ (current.first + chosen.first) / 2, (current.second + chosen.second) / 2 }, false);
+                grid.set(chosen, false);
+                stack.push_back(chosen);
+            }
+        }
+
+        /**
+         * Random rooms joined by corridors, carved until the walls left are the density given
+         */
+        static void GenerateRooms(ObstacleGrid& grid, const Coordinate& size, const std::uint64_t seed, const double density)
+        {
+            Fill(grid);
+            if (size.first < 3 || size.second < 3) return;
+
+            RandomGenerator random(seed);
+            const size_t total = (size_t)size.first * size.second;
+            const auto target = (size_t)((1.f - std::clamp(density, 0., 1.)) * total);
+            const int maxSide = std::max(3, std::min(size.first, size.second) / 4);
+
+            size_t carved = 0;
+            const auto carve = [&](const int x, const int y)
+            {
+                carved += grid.test({ x, y });
+                grid.set({ x, y }, false);
+            };
+
+            // Enough attempts to cover the board several times with average rooms
+            auto attempts = 8 * total / ((maxSide + 3) * (maxSide + 3) / 4) + 1;
+            Coordinate previous{ -1, -1 };
+
+            while (carved < target && attempts--)
+            {
+                const int width = 3 + random.nextBelow(maxSide - 2);
+                const int height = 3 + random.nextBelow(maxSide - 2);
+                const int x = 1 + random.nextBelow(std::max(1, size.first - width - 1));
+                const int y = 1 + random.nextBelow(std::max(1, size.second - height - 1));
+
+                for (int i = x; i < std::min(x + width, size.first - 1); ++i)
+                {
+                    for (int j = y; j < std::min(y + height, size.second - 1); ++j)
+                    {
+                        carve(i, j);
+                    }
+                }
+
+                // Join the center of the room with the previous one, first horizontally and then vertically
+                const Coordinate center{ std::min(x + width / 2, size.first - 2), std::min(y + height / 2, size.second - 2) };
+                if (previous.first >= 0)
+                {
+                    for (int i = std::min(previous.first, center.first); i <= std::max(previous.first, center.first); ++i)
+                    {
+                        carve(i, previous.second);
+                    }
+                    for (int j = std::min(previous.second, center.second); j <= std::max(previous.second, center.second); ++j)
+                    {
+                        carve(center.first, j);
+                    }
+                }
+                previous = center;
+            }
+        }
+
+        /**
+         * Grid of streets around square blocks, each block is built with the probability given
+         */
+        static void GenerateCityBlocks(ObstacleGrid& grid, const Coordinate& size, const std::uint64_t seed, const double density)
+        {
+            const int period = m_blockSize + m_streetWidth;
+
+            ForEachChunk(size, seed, [&](const int first, const int last, RandomGenerator&)
+            {
+                for (int i = first; i < last; ++i)
+                {
+                    // Streets are free, blocks are decided by a hash of their position so chunks are independent
+                    FillColumn(grid, i, [&](const int j)
+                    {
+                        if (i % period < m_streetWidth || j % period < m_streetWidth) return false;
+
+                        auto blockSeed = seed ^ ((std::uint64_t)(i / period) << 32 | (std::uint32_t)(j / period));
+                        return (RandomGenerator::splitMix(blockSeed) >> 11) * 0x1.0p-53 < density;
+                    });
+                }
+            });
+        }
+
+        /**
+         * Sets every bit of the grid
+         */
+        static void Fill(ObstacleGrid& grid)
+        {
+            for (int i = 0; i < grid.getSize().first; ++i)
+            {
+                FillColumn(grid, i, [](const int) { return true; });
+            }
+        }
+
+        /**
+         * Writes a whole column of the grid word by word
+         *
+         * @param grid Grid to write to
+         * @param x Column to write
+         * @param function Function called with every row of the column, returning if it is an obstacle
+         */
+        template<class F>
+        static void FillColumn(ObstacleGrid& grid, const int x, F&& function)
+        {
+            auto* word = grid.getColumn(x);
+            for (int j = 0; j < grid.getSize().second; ++word)
+            {
+                BitGrid::Word bits = 0;
+                for (int b = 0; b < BitGrid::WordBits && j < grid.getSize().second; ++b, ++j)
+                {
+                    bits |= BitGrid::Word(function(j)) << b;
+                }
+                *word = bits;
+            }
+        }
+
+        /**
+         * Calls the function given for every chunk of columns of the board, in parallel for big boards.
+         * Every chunk has its own random stream derived from the seed, so the result is always the same
+         *
+         * @param size Size of the board
+         * @param seed Seed from which the seed of every chunk is derived
+         * @param function Function called with the first column, the last column (not included) and the random stream
+         */
+        template<class F>
+        static void ForEachChunk(const Coordinate& size, const std::uint64_t seed, F&& function)
+        {
+            const size_t chunks = (size.first + m_chunkColumns - 1) / m_chunkColumns;
+
+            const auto run = [&](const size_t firstChunk, const size_t step)
+            {
+                for (size_t chunk = firstChunk; chunk < chunks; chunk += step)
+                {
+                    // The seed is mixed before adding the chunk, so consecutive seeds don't share the streams of their chunks
+                    auto seedState = seed;
+                    auto chunkSeed = RandomGenerator::splitMix(seedState) ^ chunk;
+                    RandomGenerator random(RandomGenerator::splitMix(chunkSeed));
+
+                    const int first = (int)(chunk * m_chunkColumns);
+                    function(first, std::min(first + (int)m_chunkColumns, size.first), random);
+                }
+            };
+
+            const size_t threads = (size_t)size.first * size.second < m_parallelNodes ? 1
+                : std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()), chunks);
+
+            std::vector<std::thread> workers;
+            for (size_t t = 1; t < threads; ++t)
+            {
+                workers.emplace_back(run, t, threads);
+            }
+
+            run(0, threads);
+
+            for (auto& worker : workers)
+            {
+                worker.join();
+            }
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,95 @@
+#ifndef RANDOM_GENERATOR_H
+#define RANDOM_GENERATOR_H
+#pragma once
+
+#include <cstdint>
+
+
+namespace PathFinding
+{
+    /// Fast and reproducible pseudo random generator (xoshiro256**), seeded with splitmix64
+    class RandomGenerator
+    {
+    private:
+        /// State of the generator
+        std::uint64_t m_state[4];
+
+    public:
+        /**
+         * Create a generator with the seed given, the same seed always produces the same sequence
+         *
+         * @param seed Seed of the generator
+         */
+        explicit RandomGenerator(std::uint64_t seed = 0)
+        {
+            for (auto& state : m_state)
+            {
+                state = splitMix(seed);
+            }
+        }
+
+        /**
+         * Returns the next random number
+         *
+         * @return Next random number of the sequence
+         */
+        inline std::uint64_t next()
+        {
+            const auto result = rotl(m_state[1] * 5, 7) * 9;
+            const auto t = m_state[1] << 17;
+
+            m_state[2] ^= m_state[0];
+            m_state[3] ^= m_state[1];
+            m_state[1] ^= m_state[2];
+            m_state[0] ^= m_state[3];
+            m_state[2] ^= t;
+            m_state[3] = rotl(m_state[3], 45);
+
+            return result;
+        }
+
+        /**
+         * Returns a random number in [0, bound)
+         *
+         * @param bound Upper bound, not included
+         * @return Random number in [0, bound)
+         */
+        inline std::uint32_t nextBelow(const std::uint32_t bound)
+        {
+            // Multiply and keep the high part, the bias is negligible for the bounds of a board
+            return (std::uint32_t)(((next() >> 32) * bound) >> 32);
+        }
+
+        /**
+         * Returns a random number in [0, 1)
+         *
+         * @return Random number in [0, 1)
+         */
+        inline double nextDouble()
+        {
+            return (next() >> 11) * 0x1.0p-53;
+        }
+
+        /**
+         * Advances the seed given and returns a well mixed number from it, useful to derive independent seeds
+         *
+         * @param seed Seed to advance
+         * @return Mixed number
+         */
+        static inline std::uint64_t splitMix(std::uint64_t& seed)
+        {
+            auto z = (seed += 0x9e3779b97f4a7c15);
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+            return z ^ (z >> 31);
+        }
+
+    private:
+        static inline std::uint64_t rotl(const std::uint64_t x, const int k)
+        {
+            return (x << k) | (x >> (64 - k));
+        }
+    };
+}
+
+#endif
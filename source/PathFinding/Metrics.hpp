@@ -0,0 +1,124 @@
+#ifndef METRICS_H
+#define METRICS_H
+#pragma once
+
+#include <algorithm>
+#include <ostream>
+#include <string>
+
+/// Define PATHFINDING_METRICS to collect the metrics, otherwise they are compiled out entirely
+#ifdef PATHFINDING_METRICS
+#define PATHFINDING_METRIC(...) __VA_ARGS__
+#else
+#define PATHFINDING_METRIC(...)
+#endif
+
+
+namespace PathFinding
+{
+    /// Format in which the metrics are exported
+    enum class MetricsFormat
+    {
+        CSV,
+        JSON
+    };
+
+    /// Counters of the hot path of the algorithms, collected per run
+    struct Metrics
+    {
+        /// Number of nodes pushed into the collection of nodes to be evaluated
+        unsigned long pushes = 0;
+
+        /// Number of nodes popped from the collection of nodes to be evaluated
+        unsigned long pops = 0;
+
+        /// Number of times an already opened node got a better parent
+        unsigned long decreaseKeys = 0;
+
+        /// Number of accessible neighbors checked
+        unsigned long neighborChecks = 0;
+
+        /// Number of already evaluated nodes opened again
+        unsigned long reopenings = 0;
+
+        /// Maximum number of nodes waiting to be evaluated at the same time
+        size_t peakOpenNodes = 0;
+
+        /// Approximate memory used by the board, in bytes
+        size_t boardMemory = 0;
+
+        /// Approximate maximum memory used by the board and the collection of nodes to be evaluated, in bytes
+        size_t peakMemory = 0;
+
+        /// Wall time of the init phase, in microseconds
+        double initTime = 0.f;
+
+        /// Wall time of the search phase, in microseconds
+        double searchTime = 0.f;
+
+        /**
+         * Resets every counter
+         */
+        void reset()
+        {
+            *this = {};
+        }
+
+        /**
+         * Updates the peaks with the current size of the collection of nodes to be evaluated
+         *
+         * @param openNodes Number of nodes waiting to be evaluated
+         * @param nodeBytes Bytes used by each node waiting to be evaluated
+         */
+        inline void updateOpenNodes(const size_t openNodes, const size_t nodeBytes)
+        {
+            peakOpenNodes = std::max(peakOpenNodes, openNodes);
+            peakMemory = std::max(peakMemory, boardMemory + openNodes * nodeBytes);
+        }
+
+        /**
+         * Writes the header of the metrics, only needed for CSV
+         *
+         * @param os Stream to write to
+         * @param format Format of the metrics
+         */
+        static void writeHeader(std::ostream& os, const MetricsFormat format)
+        {
+            if (format != MetricsFormat::CSV) return;
+
+            os << "algorithm,nodesOpened,nodesClosed,pushes,pops,decreaseKeys,neighborChecks,reopenings,"
+               << "peakOpenNodes,peakMemory,initTime,searchTime\n";
+        }
+
+        /**
+         * Writes the metrics of a run, as a CSV row or a JSON object per line
+         *
+         * @param os Stream to write to
+         * @param format Format of the metrics
+         * @param name Name of the algorithm
+         * @param nodesOpened Number of nodes opened
+         * @param nodesClosed Number of nodes closed
+         */
+        void write(std::ostream& os, const MetricsFormat format, const std::string& name,
+                   const unsigned long nodesOpened, const unsigned long nodesClosed) const
+        {
+            if (format == MetricsFormat::CSV)
+            {
+                os << name << ',' << nodesOpened << ',' << nodesClosed << ',' << pushes << ',' << pops << ','
+                   << decreaseKeys << ',' << neighborChecks << ',' << reopenings << ',' << peakOpenNodes << ','
+                   << peakMemory << ',' << initTime << ',' << searchTime << '\n';
+            }
+            else
+            {
+                os << "{\"algorithm\":\"" << name << "\",\"nodesOpened\":" << nodesOpened
+                   << ",\"nodesClosed\":" << nodesClosed << ",\"pushes\":" << pushes << ",\"pops\":" << pops
+                   << ",\"decreaseKeys\":" << decreaseKeys << ",\"neighborChecks\":" << neighborChecks
+                   << ",\"reopenings\":" << reopenings << ",\"peakOpenNodes\":" << peakOpenNodes
+                   << ",\"peakMemory\":" << peakMemory << ",\"initTime\":" << initTime
+                   << ",\"searchTime\":" << searchTime << "}\n";
+            }
+        }
+    };
+}
+
+#endif
@@ -2,10 +2,22 @@
 #define CONSOLE_OUTPUT_H
 #pragma once
 
+#include <algorithm>
+#include <cstdint>
 #include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
 #include "../Algorithms/AlgorithmBase.hpp"
 #include "../Board.hpp"
 
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#endif
+
 
 namespace PathFinding
 {
@@ -22,10 +34,10 @@ namespace PathFinding
 		SouthEast = 9
 	};
 
-	enum class Char : char
+	enum class Char : unsigned char
 	{
-        // Support for MacOS terminal
-#if __APPLE__
+        // Support for MacOS and Linux terminals, the box drawing characters are only on the Windows code page
+#ifndef _WIN32
         Space = 32,
         Slash = 47,
         Zero = 48,
@@ -80,44 +92,345 @@ namespace PathFinding
 		/// Works better with odd numbers
 		static const size_t m_nodeChars = 3;
 
+		/// Number of lines of the header, before the board
+		static const size_t m_headerLines = 3;
+
+		/// Frame being composed, reused so it is only allocated once
+		static inline std::string m_frame;
+
+		/// Coordinates of the solution from the goal, also when it is stored as directions, reused so it is only allocated once
+		static inline std::vector<Coordinate> m_solution;
+
+		/// Index on the solution of every node of the board, reused so it is only allocated once
+		static inline std::vector<size_t> m_solutionIndex;
+
+		/// Positions of the nodes to redraw, reused so it is only allocated once
+		static inline std::vector<Coordinate> m_changed;
+
+		/// Summed-area table of the board with the obstacles on the low half and the evaluated nodes on the high half
+		static inline std::vector<std::uint64_t> m_summedArea;
+
+		/// Blocks of the overview crossed by the solution, reused so it is only allocated once
+		static inline std::vector<bool> m_pathBlocks;
+
+		/// Characters of the overview by obstacle density, from free to full
+		static constexpr const char* m_densityChars = " .:-=+*%#@";
+
 	public:
 		static void Print(const AlgorithmBase& algorithm, const bool& clear = true, const bool& enterToContinue = false)
 		{
-            std::cout << "Algorithm: " << algorithm.name << std::endl;
-            std::cout << "Nodes opened: " << algorithm.nodesOpened << " - Nodes closed: " << algorithm.nodesClosed << std::endl;
-            if (algorithm.solution.size())
-            {
-                std::cout << "Solution (distance: " << algorithm.getSolutionDistance() << "):" << std::endl;
-            }
-            else
-            {
-                std::cout << "No solution:" << std::endl;
-            }
+			m_frame.clear();
+			Compose(algorithm);
+			Write(m_frame);
+
+			if (enterToContinue)
+				EnterToContinue(clear);
+		}
+
+		/**
+		 * Draws the frame over the previous one moving the cursor, instead of clearing the screen
+		 *
+		 * @param algorithm Algorithm to draw
+		 */
+		static void Redraw(const AlgorithmBase& algorithm)
+		{
+			// Cursor to the upper left corner, clearing every line after its content
+			m_frame.assign("\x1b[H");
+			Compose(algorithm, true);
+			m_frame += "\x1b[J";
+			Write(m_frame);
+		}
 
+		/**
+		 * Draws only the nodes changed since the last frame over it, and consumes the changes of the algorithm.
+		 * The whole frame must have been drawn with Redraw before, with the changes of the algorithm tracked
+		 *
+		 * @param algorithm Algorithm to draw
+		 * @param enterToContinue Wait for the user to press enter after drawing
+		 */
+		static void RedrawChanges(AlgorithmBase& algorithm, const bool& enterToContinue = false)
+		{
 			// Calculate the size by axis of the board
 			const Coordinate size(algorithm.getSize().first * (m_nodeChars + 1) + 1, algorithm.getSize().second * (m_nodeChars + 1) + 1);
 
-			// Stores the total position of the std::cout
-			Coordinate i;
-			for (i.second = 0; i.second < size.second; ++i.second)
+			// The counters are on the second line of the header
+			m_frame.assign("\x1b[2;1H");
+			m_frame += "Nodes opened: " + std::to_string(algorithm.nodesOpened) + " - Nodes closed: " + std::to_string(algorithm.nodesClosed) + "\x1b[K";
+
+			if (algorithm.hasSolution())
+				indexSolution(algorithm);
+
+			// A node can change several times between frames, but it is drawn once
+			m_changed.clear();
+			for (const auto& change : algorithm.changes)
 			{
-				for (i.first = 0; i.first < size.first; ++i.first)
+				m_changed.push_back(change.position);
+			}
+			std::sort(m_changed.begin(), m_changed.end());
+			m_changed.erase(std::unique(m_changed.begin(), m_changed.end()), m_changed.end());
+
+			for (const auto& node : m_changed)
+			{
+				// Move the cursor to every line inside the node, the escape codes are 1-based
+				for (size_t row = 1; row <= m_nodeChars; ++row)
 				{
-					std::cout << getRepresentation(algorithm, size, i);
+					const size_t line = m_headerLines + node.second * (m_nodeChars + 1) + row;
+					m_frame += "\x1b[" + std::to_string(line + 1) + ";" + std::to_string(node.first * (m_nodeChars + 1) + 2) + "H";
+
+					for (size_t column = 1; column <= m_nodeChars; ++column)
+					{
+						const Coordinate i(node.first * (m_nodeChars + 1) + column, node.second * (m_nodeChars + 1) + row);
+						m_frame += getRepresentation(algorithm, size, i);
+					}
 				}
-				std::cout << std::endl;
 			}
 
+			// Leave the cursor after the board
+			m_frame += "\x1b[" + std::to_string(m_headerLines + size.second + 1) + ";1H\x1b[K";
+			Write(m_frame);
+
+			algorithm.changes.clear();
+
 			if (enterToContinue)
-				EnterToContinue(clear);
+				EnterToContinue();
+		}
+
+		/**
+		 * Prints an overview of a board too big to be printed, where every character aggregates a block of nodes.
+		 * The character shows the density of obstacles, the background the density of evaluated nodes, and the
+		 * blocks crossed by the solution are marked. The blocks are counted on a summed-area table, so the cost of
+		 * every character doesn't depend on the number of nodes it aggregates
+		 *
+		 * @param algorithm Algorithm to print
+		 * @param terminalSize Number of columns and rows available for the board
+		 * @param zoom Magnification of the view, 1 shows the whole board
+		 * @param center Node at the center of the view when zoomed, the center of the board by default
+		 * @param enterToContinue Wait for the user to press enter after printing
+		 */
+		static void PrintOverview(const AlgorithmBase& algorithm, const Coordinate& terminalSize = { 80, 24 }, const double zoom = 1.f,
+			const Coordinate& center = { -1, -1 }, const bool& enterToContinue = false)
+		{
+			const auto boardSize = algorithm.getSize();
+			const auto start = algorithm.getStart();
+			const auto goal = algorithm.getGoal();
+
+			// Area of the board in view, kept inside the board
+			const Coordinate view(std::clamp((int)(boardSize.first / std::max(zoom, 1.)), 1, std::max(boardSize.first, 1)),
+				std::clamp((int)(boardSize.second / std::max(zoom, 1.)), 1, std::max(boardSize.second, 1)));
+			const Coordinate middle = center.first < 0 ? Coordinate(boardSize.first / 2, boardSize.second / 2) : center;
+			const Coordinate origin(std::clamp(middle.first - view.first / 2, 0, boardSize.first - view.first),
+				std::clamp(middle.second - view.second / 2, 0, boardSize.second - view.second));
+
+			// Nodes aggregated by every character
+			const Coordinate block((view.first + terminalSize.first - 1) / std::max(terminalSize.first, 1),
+				(view.second + terminalSize.second - 1) / std::max(terminalSize.second, 1));
+			const Coordinate blocks((view.first + block.first - 1) / block.first, (view.second + block.second - 1) / block.second);
+
+			buildSummedArea(algorithm);
+
+			m_pathBlocks.assign((size_t)blocks.first * blocks.second, false);
+			algorithm.getSolution(m_solution);
+			for (const auto& node : m_solution)
+			{
+				const Coordinate c((node.first - origin.first) / block.first, (node.second - origin.second) / block.second);
+				if (node.first >= origin.first && node.second >= origin.second && c.first < blocks.first && c.second < blocks.second)
+					m_pathBlocks[c.first * blocks.second + c.second] = true;
+			}
+
+			std::ostringstream header;
+			header << "Algorithm: " << algorithm.name << "\n";
+			header << "Nodes opened: " << algorithm.nodesOpened << " - Nodes closed: " << algorithm.nodesClosed << "\n";
+			header << "Overview of (" << origin.first << ", " << origin.second << ") to (" << origin.first + view.first - 1 << ", "
+				<< origin.second + view.second - 1 << "), each character is " << block.first << "x" << block.second << " nodes";
+			if (algorithm.hasSolution())
+				header << " (solution distance: " << algorithm.getSolutionDistance() << ")";
+			header << ":\n";
+
+			m_frame = header.str();
+			m_frame.reserve(m_frame.size() + (blocks.first * 12 + 8) * blocks.second);
+
+			Coordinate c;
+			for (c.second = 0; c.second < blocks.second; ++c.second)
+			{
+				int background = -1;
+				for (c.first = 0; c.first < blocks.first; ++c.first)
+				{
+					const Coordinate from(origin.first + c.first * block.first, origin.second + c.second * block.second);
+					const Coordinate to(std::min(from.first + block.first, origin.first + view.first),
+						std::min(from.second + block.second, origin.second + view.second));
+
+					const auto nodes = (std::uint64_t)(to.first - from.first) * (to.second - from.second);
+					const auto sum = getBlockSum(boardSize, from, to);
+					const auto obstacles = sum & 0xffffffff;
+					const auto evaluated = sum >> 32;
+
+					// Shades of the background by the fraction of evaluated nodes, none if no node was evaluated
+					const int shade = evaluated ? 1 + (int)(evaluated * 2 / std::max<std::uint64_t>(nodes - obstacles, 1)) : 0;
+					if (shade != background)
+					{
+						static const char* backgrounds[]{ "\x1b[49m", "\x1b[48;5;22m", "\x1b[48;5;28m", "\x1b[48;5;34m" };
+						m_frame += backgrounds[std::min(shade, 3)];
+						background = shade;
+					}
+
+					const auto inBlock = [&](const Coordinate& node)
+					{
+						return node.first >= from.first && node.first < to.first && node.second >= from.second && node.second < to.second;
+					};
+
+					if (inBlock(start))
+						m_frame += (char)Char::Start;
+					else if (inBlock(goal))
+						m_frame += (char)Char::Goal;
+					else if (m_pathBlocks[c.first * blocks.second + c.second])
+						m_frame += 'o';
+					else
+						m_frame += m_densityChars[obstacles ? 1 + obstacles * 8 / nodes : 0];
+				}
+				m_frame += "\x1b[0m\n";
+			}
+
+			Write(m_frame);
+
+			if (enterToContinue)
+				EnterToContinue(true);
 		}
 
 		static void ClearScreen()
-        {
-#ifndef __APPLE__
-            system("CLS");
+		{
+			Write("\x1b[2J\x1b[H");
+		}
+
+	private:
+		/**
+		 * Composes the header and the board of the algorithm at the end of the frame
+		 *
+		 * @param algorithm Algorithm to compose
+		 * @param clearLines Clear the rest of every line, so it can be drawn over a previous frame
+		 */
+		static void Compose(const AlgorithmBase& algorithm, const bool clearLines = false)
+		{
+			const char* endLine = clearLines ? "\x1b[K\n" : "\n";
+
+			std::ostringstream header;
+			header << "Algorithm: " << algorithm.name << endLine;
+			header << "Nodes opened: " << algorithm.nodesOpened << " - Nodes closed: " << algorithm.nodesClosed << endLine;
+			if (algorithm.hasSolution())
+			{
+				header << "Solution (distance: " << algorithm.getSolutionDistance() << "):" << endLine;
+			}
+			else
+			{
+				header << "No solution:" << endLine;
+			}
+			m_frame += header.str();
+
+			// Calculate the size by axis of the board
+			const Coordinate size(algorithm.getSize().first * (m_nodeChars + 1) + 1, algorithm.getSize().second * (m_nodeChars + 1) + 1);
+			m_frame.reserve(m_frame.size() + (size.first + 4) * size.second + 8);
+
+			indexSolution(algorithm);
+
+			// Stores the total position on the frame
+			Coordinate i;
+			for (i.second = 0; i.second < size.second; ++i.second)
+			{
+				for (i.first = 0; i.first < size.first; ++i.first)
+				{
+					m_frame += getRepresentation(algorithm, size, i);
+				}
+				m_frame += endLine;
+			}
+		}
+
+		/**
+		 * Writes the text given with a single write
+		 *
+		 * @param text Text to write
+		 */
+		static void Write(const std::string& text)
+		{
+#ifdef _WIN32
+			// The Windows console only understands the escape codes once enabled
+			static const bool ansi = []()
+			{
+				auto handle = GetStdHandle(STD_OUTPUT_HANDLE);
+				DWORD mode = 0;
+				return GetConsoleMode(handle, &mode) && SetConsoleMode(handle, mode | ENABLE_VIRTUAL_TERMINAL_PROCESSING);
+			}();
 #endif
-        }
+			std::cout.write(text.data(), text.size());
+			std::cout.flush();
+		}
+
+		/**
+		 * Stores the index on the solution of every node of the board, so it isn't searched for every character
+		 *
+		 * @param algorithm Algorithm of which the solution is indexed
+		 */
+		static void indexSolution(const AlgorithmBase& algorithm)
+		{
+			algorithm.getSolution(m_solution);
+			const auto boardSize = algorithm.getSize();
+
+			m_solutionIndex.assign(algorithm.getTotalSize(), m_solution.size());
+			for (size_t i = 0; i < m_solution.size(); ++i)
+			{
+				m_solutionIndex[m_solution[i].first * boardSize.second + m_solution[i].second] = i;
+			}
+		}
+
+		/**
+		 * Builds the summed-area table of the obstacles and the evaluated nodes of the board, so the number of
+		 * both inside any block is known with four lookups
+		 *
+		 * @param algorithm Algorithm of which the table is built
+		 */
+		static void buildSummedArea(const AlgorithmBase& algorithm)
+		{
+			const auto boardSize = algorithm.getSize();
+			const size_t height = boardSize.second + 1;
+
+			// The first column and row are zeros, so blocks on the borders need no special case
+			m_summedArea.assign((boardSize.first + 1) * height, 0);
+			for (int i = 0; i < boardSize.first; ++i)
+			{
+				std::uint64_t column = 0;
+				for (int j = 0; j < boardSize.second; ++j)
+				{
+					switch (algorithm.getState({ i, j }))
+					{
+						case NodeState::Obstacle:
+							column += 1;
+							break;
+
+						case NodeState::Opened:
+						case NodeState::Closed:
+							column += std::uint64_t(1) << 32;
+							break;
+
+						default:
+							break;
+					}
+					m_summedArea[(i + 1) * height + j + 1] = m_summedArea[i * height + j + 1] + column;
+				}
+			}
+		}
+
+		/**
+		 * Returns the sums of the block given, both counters stay packed as none of them can go negative
+		 *
+		 * @param boardSize Size of the board
+		 * @param from First node of the block
+		 * @param to Node after the last one of the block
+		 * @return Number of obstacles on the low half and evaluated nodes on the high half
+		 */
+		static std::uint64_t getBlockSum(const Coordinate& boardSize, const Coordinate& from, const Coordinate& to)
+		{
+			const size_t height = boardSize.second + 1;
+			return m_summedArea[to.first * height + to.second] - m_summedArea[from.first * height + to.second]
+				- m_summedArea[to.first * height + from.second] + m_summedArea[from.first * height + from.second];
+		}
 
     private:
 		static char getRepresentation(const AlgorithmBase& algorithm, const Coordinate& size, const Coordinate& coutPos)
@@ -133,8 +446,8 @@ namespace PathFinding
 			nextChar = nextChar == Char::Space ? getMain(algorithm, boardPos, nodeC) : nextChar;
 
 			// If a solution is passed, print the solution. If not, print the value of the node
-			if (algorithm.solution.size())
-				return nextChar == Char::Space ? (char)getSolutionPath(algorithm.solution, boardPos, nodeC) : (char)nextChar;
+			if (algorithm.hasSolution())
+				return nextChar == Char::Space ? (char)getSolutionPath(m_solution, getSolutionIndex(algorithm, boardPos), nodeC) : (char)nextChar;
 			else
 				return nextChar == Char::Space ? getNodeValue(algorithm.getValue1(boardPos), algorithm.getValue2(boardPos), nodeC) : (char)nextChar;
 
@@ -226,7 +539,14 @@ namespace PathFinding
 			return Char::Space;
 		}
 
-		static Char getSolutionPath(const std::vector<Coordinate>& solution, const Coordinate& localC, const Coordinate& nodeC)
+		static size_t getSolutionIndex(const AlgorithmBase& algorithm, const Coordinate& localC)
+		{
+			const auto boardSize = algorithm.getSize();
+			const bool valid = localC.first >= 0 && localC.first < boardSize.first && localC.second >= 0 && localC.second < boardSize.second;
+			return valid ? m_solutionIndex[localC.first * boardSize.second + localC.second] : m_solution.size();
+		}
+
+		static Char getSolutionPath(const std::vector<Coordinate>& solution, const size_t resultIndex, const Coordinate& nodeC)
 		{
 			const auto halfNodeChars = m_nodeChars / 2;
 			const bool centralColumn = nodeC.first == halfNodeChars;				// Central column
@@ -234,16 +554,6 @@ namespace PathFinding
 			const bool tlDiagonal = nodeC.first == nodeC.second;					// Top left to bottom right diagonal
 			const bool blDiagonal = nodeC.first == m_nodeChars - 1 - nodeC.second;	// Bottom left to top right diagonal
 
-			auto resultIndex = solution.size();
-            
-            for (size_t i = 0; i < solution.size(); ++i)
-            {
-                if (localC == solution[i])
-                {
-                    resultIndex = i;
-                }
-            }
-
 			// Solution path
 			if (resultIndex && resultIndex < solution.size() - 1)
 			{
@@ -0,0 +1,266 @@
+#ifndef IMAGE_OUTPUT_H
+#define IMAGE_OUTPUT_H
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "../Algorithms/AlgorithmBase.hpp"
+
+
+namespace PathFinding
+{
+    /// Format of the image files
+    enum class ImageFormat
+    {
+        PPM,
+        PNG
+    };
+
+    /// Writes the board, the evaluated nodes and the solution into image files, a pixel per node.
+    /// The image is streamed row by row, so the memory used only depends on the width of the board
+    class ImageOutput
+    {
+    private:
+        typedef std::array<std::uint8_t, 3> Color;
+
+        static constexpr Color m_free{ 255, 255, 255 };
+        static constexpr Color m_obstacle{ 40, 40, 40 };
+        static constexpr Color m_opened{ 150, 220, 150 };
+        static constexpr Color m_closed{ 140, 180, 230 };
+        static constexpr Color m_path{ 220, 40, 40 };
+        static constexpr Color m_start{ 250, 170, 0 };
+        static constexpr Color m_goal{ 160, 40, 200 };
+
+        /// Maximum size of the data of a stored deflate block
+        static constexpr size_t m_maxBlock = 65535;
+
+    public:
+        /**
+         * Writes the image of the algorithm into a file
+         *
+         * @param algorithm Algorithm to write
+         * @param path Path of the file
+         * @param format Format of the file
+         * @param scale Size in pixels of the side of every node
+         * @return Whether the file could be written or not
+         */
+        static bool Write(const AlgorithmBase& algorithm, const std::string& path, const ImageFormat format = ImageFormat::PPM, const size_t scale = 1)
+        {
+            std::ofstream file(path, std::ios::binary);
+            if (!file) return false;
+
+            const auto size = algorithm.getSize();
+            const size_t width = size.first * std::max<size_t>(scale, 1);
+            const size_t height = size.second * std::max<size_t>(scale, 1);
+
+            if (format == ImageFormat::PPM)
+            {
+                file << "P6\n" << width << " " << height << "\n255\n";
+                ForEachRow(algorithm, scale, [&](const std::vector<std::uint8_t>& row, const bool)
+                {
+                    file.write((const char*)row.data(), row.size());
+                });
+            }
+            else
+            {
+                WritePNG(file, algorithm, width, height, scale);
+            }
+
+            return (bool)file;
+        }
+
+    private:
+        /**
+         * Calls the function given with the RGB pixels of every row of the image, from top to bottom
+         *
+         * @param algorithm Algorithm to write
+         * @param scale Size in pixels of the side of every node
+         * @param function Function called with the pixels of the row and whether it is the last row or not
+         */
+        template<class F>
+        static void ForEachRow(const AlgorithmBase& algorithm, size_t scale, F&& function)
+        {
+            const auto size = algorithm.getSize();
+            scale = std::max<size_t>(scale, 1);
+
+            // Walk the solution sorted by rows, so the path of every row is known without a full board
+            std::vector<Coordinate> path;
+            algorithm.getSolution(path);
+            std::sort(path.begin(), path.end(), [](const Coordinate& c1, const Coordinate& c2)
+            {
+                return c1.second == c2.second ? c1.first < c2.first : c1.second < c2.second;
+            });
+            auto pathNode = path.begin();
+
+            std::vector<std::uint8_t> row(size.first * scale * 3);
+            for (int j = 0; j < size.second; ++j)
+            {
+                auto* pixel = row.data();
+                for (int i = 0; i < size.first; ++i)
+                {
+                    const Coordinate c{ i, j };
+
+                    while (pathNode != path.end() && (pathNode->second < j || (pathNode->second == j && pathNode->first < i))) ++pathNode;
+                    const bool inPath = pathNode != path.end() && *pathNode == c;
+
+                    const auto color = getColor(algorithm, c, inPath);
+                    for (size_t s = 0; s < scale; ++s)
+                    {
+                        pixel = std::copy(color.begin(), color.end(), pixel);
+                    }
+                }
+
+                for (size_t s = 0; s < scale; ++s)
+                {
+                    function(row, j == size.second - 1 && s == scale - 1);
+                }
+            }
+        }
+
+        static Color getColor(const AlgorithmBase& algorithm, const Coordinate& c, const bool inPath)
+        {
+            if (c == algorithm.getStart())
+                return m_start;
+
+            else if (c == algorithm.getGoal())
+                return m_goal;
+
+            else if (inPath)
+                return m_path;
+
+            Color color = m_free;
+            switch (algorithm.getState(c))
+            {
+                case NodeState::Obstacle:
+                    return m_obstacle;
+
+                case NodeState::Opened:
+                    color = m_opened;
+                    break;
+
+                case NodeState::Closed:
+                    color = m_closed;
+                    break;
+
+                default:
+                    break;
+            }
+
+            // Darken the nodes more expensive to traverse
+            const int cost = algorithm.getCost(c);
+            if (cost > 1)
+            {
+                const int factor = std::max(64, 256 - cost * 8);
+                for (auto& channel : color) channel = (std::uint8_t)(channel * factor / 256);
+            }
+            return color;
+        }
+
+        /**
+         * Writes a PNG without compression, with a chunk of image data per row, so it needs no external library
+         */
+        static void WritePNG(std::ofstream& file, const AlgorithmBase& algorithm, const size_t width, const size_t height, const size_t scale)
+        {
+            static const std::uint8_t signature[8]{ 137, 'P', 'N', 'G', '\r', '\n', 26, '\n' };
+            file.write((const char*)signature, sizeof(signature));
+
+            std::vector<std::uint8_t> data;
+            appendBigEndian(data, (std::uint32_t)width);
+            appendBigEndian(data, (std::uint32_t)height);
+            data.insert(data.end(), { 8, 2, 0, 0, 0 });     // 8 bits per channel, RGB, deflate, no filter, no interlace
+            writeChunk(file, "IHDR", data);
+
+            // zlib header of a deflate stream without compression
+            data.assign({ 0x78, 0x01 });
+            std::uint32_t adler1 = 1, adler2 = 0;
+
+            ForEachRow(algorithm, scale, [&](const std::vector<std::uint8_t>& row, const bool last)
+            {
+                // Every row starts with its filter type, none
+                const std::uint8_t filter = 0;
+                size_t written = 0;
+                const size_t total = row.size() + 1;
+
+                while (written < total)
+                {
+                    const size_t block = std::min(total - written, m_maxBlock);
+                    const bool final = last && written + block == total;
+
+                    data.push_back(final ? 1 : 0);
+                    data.push_back(block & 0xff);
+                    data.push_back(block >> 8);
+                    data.push_back(~block & 0xff);
+                    data.push_back((~block >> 8) & 0xff);
+
+                    for (size_t i = written; i < written + block; ++i)
+                    {
+                        const auto byte = i ? row[i - 1] : filter;
+                        data.push_back(byte);
+                        adler1 = (adler1 + byte) % 65521;
+                        adler2 = (adler2 + adler1) % 65521;
+                    }
+                    written += block;
+                }
+
+                if (last) appendBigEndian(data, adler2 << 16 | adler1);
+
+                writeChunk(file, "IDAT", data);
+                data.clear();
+            });
+
+            writeChunk(file, "IEND", data);
+        }
+
+        static void appendBigEndian(std::vector<std::uint8_t>& data, const std::uint32_t value)
+        {
+            data.insert(data.end(), { (std::uint8_t)(value >> 24), (std::uint8_t)(value >> 16), (std::uint8_t)(value >> 8), (std::uint8_t)value });
+        }
+
+        static void writeChunk(std::ofstream& file, const char* type, const std::vector<std::uint8_t>& data)
+        {
+            std::vector<std::uint8_t> header;
+            appendBigEndian(header, (std::uint32_t)data.size());
+            header.insert(header.end(), type, type + 4);
+            file.write((const char*)header.data(), header.size());
+            file.write((const char*)data.data(), data.size());
+
+            // The CRC covers the type and the data
+            auto crc = crc32(0xffffffff, (const std::uint8_t*)type, 4);
+            crc = crc32(crc, data.data(), data.size()) ^ 0xffffffff;
+
+            std::vector<std::uint8_t> footer;
+            appendBigEndian(footer, crc);
+            file.write((const char*)footer.data(), footer.size());
+        }
+
+        static std::uint32_t crc32(std::uint32_t crc, const std::uint8_t* data, const size_t size)
+        {
+            static const auto table = []()
+            {
+                std::array<std::uint32_t, 256> table{};
+                for (std::uint32_t n = 0; n < 256; ++n)
+                {
+                    auto c = n;
+                    for (int k = 0; k < 8; ++k)
+                    {
+                        c = c & 1 ? 0xedb88320 ^ (c >> 1) : c >> 1;
+                    }
+                    table[n] = c;
+                }
+                return table;
+            }();
+
+            for (size_t i = 0; i < size; ++i)
+            {
+                crc = table[(crc ^ data[i]) & 0xff] ^ (crc >> 8);
+            }
+            return crc;
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,673 @@
+#ifndef WEB_OUTPUT_H
+#define WEB_OUTPUT_H
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../Algorithms/AlgorithmBase.hpp"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#pragma comment(lib, "Ws2_32.lib")
+#else
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+
+namespace PathFinding
+{
+    /// Serves a viewer on localhost and streams to it the nodes changed on every step of the algorithms.
+    /// The changes are sent from a thread of its own, while the client is slow the steps are coalesced and
+    /// every node is sent once with its last state
+    class WebOutput
+    {
+    private:
+#ifdef _WIN32
+        typedef SOCKET Socket;
+        static constexpr Socket m_invalidSocket = INVALID_SOCKET;
+#else
+        typedef int Socket;
+        static constexpr Socket m_invalidSocket = -1;
+#endif
+
+        /// Type of the binary messages, the first byte of each one
+        enum class Message : std::uint8_t
+        {
+            Snapshot,
+            Changes,
+            Solution
+        };
+
+        /// Minimum time between messages, so the client isn't sent more than it can draw
+        static constexpr std::chrono::milliseconds m_frameInterval{ 16 };
+
+        /// Maximum time a receive or a send waits for a connection, so a client that stops sending or reading is dropped
+        /// instead of blocking the threads forever
+        static constexpr std::chrono::milliseconds m_socketTimeout{ 1000 };
+
+        /// Socket listening for connections
+        Socket m_server = m_invalidSocket;
+
+        /// Socket of the viewer connected, only used by the sender thread
+        Socket m_client = m_invalidSocket;
+
+        /// Socket of the last viewer connected, waiting for the sender thread to take it
+        Socket m_newClient = m_invalidSocket;
+
+        std::thread m_acceptor;
+        std::thread m_sender;
+        std::atomic<bool> m_stop{ false };
+
+        std::mutex m_mutex;
+        std::condition_variable m_condition;
+
+        /// Size of the board being streamed
+        Coordinate m_size{ 0, 0 };
+
+        /// Index of the start and the goal on the board
+        std::uint32_t m_start = 0, m_goal = 0;
+
+        /// Last state of every node of the board
+        std::vector<std::uint8_t> m_states;
+
+        /// Whether every node is already on the changes waiting to be sent
+        std::vector<std::uint8_t> m_dirty;
+
+        /// Index of the nodes changed since the last message
+        std::vector<std::uint32_t> m_changes;
+
+        /// Index of the nodes of the solution, once found
+        std::vector<std::uint32_t> m_solution;
+
+        /// Messages waiting to be sent besides the changes
+        bool m_snapshotPending = false, m_solutionPending = false;
+
+    public:
+        /**
+         * Starts serving the viewer on localhost
+         *
+         * @param port Port on which the viewer is served
+         */
+        explicit WebOutput(const unsigned short port = 8080)
+        {
+#ifdef _WIN32
+            WSADATA data;
+            WSAStartup(MAKEWORD(2, 2), &data);
+#endif
+            m_server = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+            if (m_server == m_invalidSocket) return;
+
+            const int reuse = 1;
+            setsockopt(m_server, SOL_SOCKET, SO_REUSEADDR, (const char*)&reuse, sizeof(reuse));
+
+            sockaddr_in address{};
+            address.sin_family = AF_INET;
+            address.sin_port = htons(port);
+            address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+            if (bind(m_server, (const sockaddr*)&address, sizeof(address)) || listen(m_server, 4))
+            {
+                closeSocket(m_server);
+                return;
+            }
+
+            m_acceptor = std::thread(&WebOutput::acceptLoop, this);
+            m_sender = std::thread(&WebOutput::sendLoop, this);
+        }
+
+        WebOutput(const WebOutput&) = delete;
+        WebOutput& operator=(const WebOutput&) = delete;
+
+        ~WebOutput()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stop = true;
+            }
+            m_condition.notify_all();
+
+            if (m_acceptor.joinable()) m_acceptor.join();
+            if (m_sender.joinable()) m_sender.join();
+
+            closeSocket(m_newClient);
+            closeSocket(m_client);
+            closeSocket(m_server);
+#ifdef _WIN32
+            WSACleanup();
+#endif
+        }
+
+        /**
+         * Checks if the viewer is being served
+         *
+         * @return If the viewer is being served
+         */
+        inline const bool isServing() const { return m_server != m_invalidSocket; }
+
+        /**
+         * Starts streaming the board of the algorithm, the viewer receives the whole board again
+         *
+         * @param algorithm Algorithm to stream, already initialized
+         */
+        void begin(const AlgorithmBase& algorithm)
+        {
+            const auto size = algorithm.getSize();
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            m_size = size;
+            m_start = getIndex(algorithm.getStart());
+            m_goal = getIndex(algorithm.getGoal());
+
+            m_states.resize(algorithm.getTotalSize());
+            for (int i = 0; i < size.first; ++i)
+            {
+                for (int j = 0; j < size.second; ++j)
+                {
+                    m_states[getIndex({ i, j })] = (std::uint8_t)algorithm.getState({ i, j });
+                }
+            }
+
+            m_dirty.assign(m_states.size(), false);
+            m_changes.clear();
+            m_solution.clear();
+            m_snapshotPending = true;
+            m_solutionPending = false;
+
+            m_condition.notify_all();
+        }
+
+        /**
+         * Queues the nodes changed since the last call, and the solution once found, and consumes the changes of the algorithm.
+         * The changes of the algorithm must be tracked
+         *
+         * @param algorithm Algorithm streamed
+         */
+        void publish(AlgorithmBase& algorithm)
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+
+                for (const auto& change : algorithm.changes)
+                {
+                    const auto index = getIndex(change.position);
+                    m_states[index] = (std::uint8_t)algorithm.getState(change.position);
+
+                    if (!m_dirty[index])
+                    {
+                        m_dirty[index] = true;
+                        m_changes.push_back(index);
+                    }
+                }
+
+                if (algorithm.hasSolution() && m_solution.empty())
+                {
+                    std::vector<Coordinate> path;
+                    algorithm.getSolution(path);
+                    for (const auto& c : path)
+                    {
+                        m_solution.push_back(getIndex(c));
+                    }
+                    m_solutionPending = true;
+                }
+            }
+
+            algorithm.changes.clear();
+            m_condition.notify_all();
+        }
+
+    private:
+        inline std::uint32_t getIndex(const Coordinate& c) const
+        {
+            return (std::uint32_t)(c.first * m_size.second + c.second);
+        }
+
+        /**
+         * Accepts the connections, serving the viewer page or upgrading them to the WebSocket of the viewer
+         */
+        void acceptLoop()
+        {
+            while (!m_stop)
+            {
+                // Wait with a timeout, so the thread notices when it has to stop
+                fd_set sockets;
+                FD_ZERO(&sockets);
+                FD_SET(m_server, &sockets);
+                timeval timeout{ 0, 100000 };
+
+                if (select((int)m_server + 1, &sockets, nullptr, nullptr, &timeout) <= 0) continue;
+
+                auto connection = accept(m_server, nullptr, nullptr);
+                if (connection == m_invalidSocket) continue;
+
+                setTimeouts(connection);
+
+                const auto request = readRequest(connection);
+                const auto key = getHeader(request, "sec-websocket-key");
+
+                if (key.size())
+                {
+                    const std::string response = "HTTP/1.1 101 Switching Protocols\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n"
+                        "Sec-WebSocket-Accept: " + getAcceptKey(key) + "\r\n\r\n";
+
+                    if (sendAll(connection, response.data(), response.size()))
+                    {
+                        // The sender thread replaces the previous viewer, if any
+                        std::lock_guard<std::mutex> lock(m_mutex);
+                        closeSocket(m_newClient);
+                        m_newClient = connection;
+                        m_condition.notify_all();
+                        continue;
+                    }
+                }
+                else if (request.rfind("GET / ", 0) == 0)
+                {
+                    const std::string page = getPage();
+                    const std::string response = "HTTP/1.1 200 OK\r\nContent-Type: text/html\r\nContent-Length: "
+                        + std::to_string(page.size()) + "\r\nConnection: close\r\n\r\n" + page;
+                    sendAll(connection, response.data(), response.size());
+                }
+                else
+                {
+                    const std::string response = "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+                    sendAll(connection, response.data(), response.size());
+                }
+
+                closeSocket(connection);
+            }
+        }
+
+        /**
+         * Sends the pending messages to the viewer, at most one every frame interval
+         */
+        void sendLoop()
+        {
+            std::vector<std::uint8_t> message;
+            std::unique_lock<std::mutex> lock(m_mutex);
+
+            while (!m_stop)
+            {
+                m_condition.wait(lock, [&]()
+                {
+                    return m_stop || m_newClient != m_invalidSocket
+                        || (m_client != m_invalidSocket && (m_snapshotPending || m_solutionPending || m_changes.size()));
+                });
+                if (m_stop) break;
+
+                if (m_newClient != m_invalidSocket)
+                {
+                    closeSocket(m_client);
+                    m_client = m_newClient;
+                    m_newClient = m_invalidSocket;
+                    m_snapshotPending = m_states.size();
+                    m_solutionPending = m_solution.size();
+                }
+
+                if (m_snapshotPending)
+                {
+                    encodeSnapshot(message);
+                    clearChanges();
+                    m_snapshotPending = false;
+                }
+                else if (m_changes.size())
+                {
+                    encodeChanges(message);
+                    clearChanges();
+                }
+                else if (m_solutionPending)
+                {
+                    encodeSolution(message);
+                    m_solutionPending = false;
+                }
+                else continue;
+
+                // Send without blocking the algorithm, the changes of the next steps are coalesced meanwhile
+                const auto sent = std::chrono::steady_clock::now();
+                const auto client = m_client;
+                lock.unlock();
+                const bool ok = sendFrame(client, message);
+                lock.lock();
+
+                if (!ok)
+                {
+                    closeSocket(m_client);
+                    continue;
+                }
+
+                m_condition.wait_until(lock, sent + m_frameInterval, [&]() { return m_stop.load(); });
+            }
+        }
+
+        void clearChanges()
+        {
+            for (const auto index : m_changes)
+            {
+                m_dirty[index] = false;
+            }
+            m_changes.clear();
+        }
+
+        /**
+         * Header, size, start and goal of the board, and the state of every node
+         */
+        void encodeSnapshot(std::vector<std::uint8_t>& message) const
+        {
+            message.assign({ (std::uint8_t)Message::Snapshot, 0, 0, 0 });
+            appendLittleEndian(message, (std::uint32_t)m_size.first);
+            appendLittleEndian(message, (std::uint32_t)m_size.second);
+            appendLittleEndian(message, m_start);
+            appendLittleEndian(message, m_goal);
+            message.insert(message.end(), m_states.begin(), m_states.end());
+        }
+
+        /**
+         * Header, number of nodes changed, their indexes and then their states, so the client reads them as typed arrays
+         */
+        void encodeChanges(std::vector<std::uint8_t>& message) const
+        {
+            message.assign({ (std::uint8_t)Message::Changes, 0, 0, 0 });
+            appendLittleEndian(message, (std::uint32_t)m_changes.size());
+            for (const auto index : m_changes)
+            {
+                appendLittleEndian(message, index);
+            }
+            for (const auto index : m_changes)
+            {
+                message.push_back(m_states[index]);
+            }
+        }
+
+        /**
+         * Header, number of nodes of the solution and their indexes
+         */
+        void encodeSolution(std::vector<std::uint8_t>& message) const
+        {
+            message.assign({ (std::uint8_t)Message::Solution, 0, 0, 0 });
+            appendLittleEndian(message, (std::uint32_t)m_solution.size());
+            for (const auto index : m_solution)
+            {
+                appendLittleEndian(message, index);
+            }
+        }
+
+        static void appendLittleEndian(std::vector<std::uint8_t>& data, const std::uint32_t value)
+        {
+            data.insert(data.end(), { (std::uint8_t)value, (std::uint8_t)(value >> 8), (std::uint8_t)(value >> 16), (std::uint8_t)(value >> 24) });
+        }
+
+        /**
+         * Sends a binary WebSocket frame, unmasked as it goes from the server
+         */
+        bool sendFrame(const Socket socket, const std::vector<std::uint8_t>& payload) const
+        {
+            std::vector<std::uint8_t> header{ 0x82 };
+            const std::uint64_t size = payload.size();
+
+            if (size < 126)
+            {
+                header.push_back((std::uint8_t)size);
+            }
+            else if (size < 65536)
+            {
+                header.insert(header.end(), { 126, (std::uint8_t)(size >> 8), (std::uint8_t)size });
+            }
+            else
+            {
+                header.push_back(127);
+                for (int shift = 56; shift >= 0; shift -= 8)
+                {
+                    header.push_back((std::uint8_t)(size >> shift));
+                }
+            }
+
+            return sendAll(socket, (const char*)header.data(), header.size()) && sendAll(socket, (const char*)payload.data(), payload.size());
+        }
+
+        /**
+         * Sends the whole data, failing if the connection times out or the output is stopped
+         */
+        bool sendAll(const Socket socket, const char* data, size_t size) const
+        {
+#ifdef MSG_NOSIGNAL
+            const int flags = MSG_NOSIGNAL;
+#else
+            const int flags = 0;
+#endif
+            while (size)
+            {
+                if (m_stop) return false;
+
+                const auto sent = send(socket, data, (int)std::min<size_t>(size, 1 << 30), flags);
+                if (sent <= 0) return false;
+
+                data += sent;
+                size -= sent;
+            }
+            return true;
+        }
+
+        /**
+         * Reads the request line and the headers of an HTTP request, until the connection times out or the output is stopped
+         */
+        std::string readRequest(const Socket socket) const
+        {
+            std::string request;
+            char buffer[1024];
+
+            while (!m_stop && request.find("\r\n\r\n") == std::string::npos && request.size() < 8192)
+            {
+                const auto received = recv(socket, buffer, sizeof(buffer), 0);
+                if (received <= 0) break;
+
+                request.append(buffer, received);
+            }
+            return request;
+        }
+
+        static std::string getHeader(const std::string& request, const std::string& name)
+        {
+            std::string lower(request);
+            std::transform(lower.begin(), lower.end(), lower.begin(), [](const char c) { return (char)std::tolower((unsigned char)c); });
+
+            auto begin = lower.find("\r\n" + name + ":");
+            if (begin == std::string::npos) return {};
+
+            begin = request.find_first_not_of(' ', begin + name.size() + 3);
+            const auto end = request.find("\r\n", begin);
+            return request.substr(begin, end == std::string::npos ? std::string::npos : end - begin);
+        }
+
+        /**
+         * Sets the timeouts of the receives and the sends of a connection
+         */
+        static void setTimeouts(const Socket socket)
+        {
+#ifdef _WIN32
+            const DWORD timeout = (DWORD)m_socketTimeout.count();
+#else
+            const timeval timeout{ (time_t)(m_socketTimeout.count() / 1000), (suseconds_t)(m_socketTimeout.count() % 1000 * 1000) };
+#endif
+            setsockopt(socket, SOL_SOCKET, SO_RCVTIMEO, (const char*)&timeout, sizeof(timeout));
+            setsockopt(socket, SOL_SOCKET, SO_SNDTIMEO, (const char*)&timeout, sizeof(timeout));
+        }
+
+        static void closeSocket(Socket& socket)
+        {
+            if (socket == m_invalidSocket) return;
+#ifdef _WIN32
+            closesocket(socket);
+#else
+            close(socket);
+#endif
+            socket = m_invalidSocket;
+        }
+
+        /**
+         * Returns the key accepting a WebSocket connection, the base64 of the SHA-1 of the key of the client and a fixed GUID
+         */
+        static std::string getAcceptKey(const std::string& key)
+        {
+            const auto hash = sha1(key + "258EAFA5-E914-47DA-95CA-C5AB0DC85B11");
+            static const char* digits = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+            std::string encoded;
+            for (size_t i = 0; i < hash.size(); i += 3)
+            {
+                const std::uint32_t group = hash[i] << 16 | (i + 1 < hash.size() ? hash[i + 1] << 8 : 0) | (i + 2 < hash.size() ? hash[i + 2] : 0);
+                encoded += digits[(group >> 18) & 63];
+                encoded += digits[(group >> 12) & 63];
+                encoded += i + 1 < hash.size() ? digits[(group >> 6) & 63] : '=';
+                encoded += i + 2 < hash.size() ? digits[group & 63] : '=';
+            }
+            return encoded;
+        }
+
+        static std::array<std::uint8_t, 20> sha1(std::string data)
+        {
+            std::uint32_t h[5]{ 0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0 };
+            const std::uint64_t bits = (std::uint64_t)data.size() * 8;
+
+            // Pad to a multiple of 64 bytes, ending with the length in bits
+            data += (char)0x80;
+            while (data.size() % 64 != 56) data += (char)0;
+            for (int shift = 56; shift >= 0; shift -= 8) data += (char)(bits >> shift);
+
+            const auto rotl = [](const std::uint32_t x, const int k) { return (x << k) | (x >> (32 - k)); };
+
+            for (size_t chunk = 0; chunk < data.size(); chunk += 64)
+            {
+                std::uint32_t w[80];
+                for (int i = 0; i < 16; ++i)
+                {
+                    const auto* bytes = (const std::uint8_t*)data.data() + chunk + i * 4;
+                    w[i] = (std::uint32_t)bytes[0] << 24 | bytes[1] << 16 | bytes[2] << 8 | bytes[3];
+                }
+                for (int i = 16; i < 80; ++i)
+                {
+                    w[i] = rotl(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+                }
+
+                auto a = h[0], b = h[1], c = h[2], d = h[3], e = h[4];
+                for (int i = 0; i < 80; ++i)
+                {
+                    std::uint32_t f, k;
+                    if (i < 20)      { f = (b & c) | (~b & d);          k = 0x5a827999; }
+                    else if (i < 40) { f = b ^ c ^ d;                   k = 0x6ed9eba1; }
+                    else if (i < 60) { f = (b & c) | (b & d) | (c & d); k = 0x8f1bbcdc; }
+                    else             { f = b ^ c ^ d;                   k = 0xca62c1d6; }
+
+                    const auto t = rotl(a, 5) + f + e + k + w[i];
+                    e = d;
+                    d = c;
+                    c = rotl(b, 30);
+                    b = a;
+                    a = t;
+                }
+
+                h[0] += a;
+                h[1] += b;
+                h[2] += c;
+                h[3] += d;
+                h[4] += e;
+            }
+
+            std::array<std::uint8_t, 20> hash;
+            for (int i = 0; i < 20; ++i)
+            {
+                hash[i] = (std::uint8_t)(h[i / 4] >> (24 - (i % 4) * 8));
+            }
+            return hash;
+        }
+
+        /**
+         * Page of the viewer, draws the board on a canvas at most once per frame of the browser
+         */
+        static std::string getPage()
+        {
+            return R"(<!DOCTYPE html>
+<html>
+<head>
+<meta charset="utf-8">
+<title>PathFinding</title>
+<style>
+body { margin: 0; background: #222; color: #ddd; font: 14px monospace; }
+#info { padding: 8px; }
+canvas { image-rendering: pixelated; max-width: 100vw; max-height: calc(100vh - 40px); width: 100vmin; }
+</style>
+</head>
+<body>
+<div id="info">Connecting...</div>
+<canvas id="board"></canvas>
+<script>
+const colors = [[255, 255, 255], [40, 40, 40], [150, 220, 150], [140, 180, 230], [220, 40, 40], [250, 170, 0], [160, 40, 200]];
+const info = document.getElementById('info');
+const canvas = document.getElementById('board');
+const context = canvas.getContext('2d');
+let width = 0, height = 0, start = 0, goal = 0, image = null, path = null, dirty = false, messages = 0;
+
+// The nodes are indexed by column, the image by row
+function paint(index, state) {
+    if (path[index]) state = 4;
+    if (index === start) state = 5;
+    if (index === goal) state = 6;
+    const p = ((index % height) * width + Math.floor(index / height)) * 4, c = colors[state];
+    image.data[p] = c[0]; image.data[p + 1] = c[1]; image.data[p + 2] = c[2]; image.data[p + 3] = 255;
+}
+
+const socket = new WebSocket('ws://' + location.host + '/ws');
+socket.binaryType = 'arraybuffer';
+socket.onmessage = (event) => {
+    const view = new DataView(event.data), type = view.getUint8(0);
+    if (type === 0) {
+        width = view.getUint32(4, true); height = view.getUint32(8, true);
+        start = view.getUint32(12, true); goal = view.getUint32(16, true);
+        canvas.width = width; canvas.height = height;
+        image = context.createImageData(width, height);
+        path = new Uint8Array(width * height);
+        const states = new Uint8Array(event.data, 20, width * height);
+        for (let i = 0; i < states.length; ++i) paint(i, states[i]);
+    } else if (image) {
+        const n = view.getUint32(4, true), indexes = new Uint32Array(event.data, 8, n);
+        if (type === 1) {
+            const states = new Uint8Array(event.data, 8 + 4 * n, n);
+            for (let i = 0; i < n; ++i) paint(indexes[i], states[i]);
+        } else {
+            for (let i = 0; i < n; ++i) { path[indexes[i]] = 1; paint(indexes[i], 4); }
+        }
+    }
+    dirty = true;
+    info.textContent = width + 'x' + height + ' - messages: ' + (++messages);
+};
+socket.onclose = () => info.textContent = 'Disconnected';
+
+function draw() {
+    if (dirty && image) { context.putImageData(image, 0, 0); dirty = false; }
+    requestAnimationFrame(draw);
+}
+requestAnimationFrame(draw);
+</script>
+</body>
+</html>
+)";
+        }
+    };
+}
+
+#endif
@@ -2,11 +2,17 @@
 #define PATH_FINDER_H
 #pragma once
 
+#include <atomic>
 #include <chrono>
+#include <memory>
 #include <thread>
-#include <unordered_map>
+#include "SearchTask.hpp"
 #include "Algorithms/AlgorithmBase.hpp"
+#include "Generators/ObstacleGenerator.hpp"
 #include "Output/ConsoleOutput.hpp"
+#include "Output/ImageOutput.hpp"
+#include "Output/WebOutput.hpp"
+#include "../Statistics.hpp"
 #include "../Timer.hpp"
 
 
@@ -15,41 +21,89 @@ namespace PathFinding
     enum class RunMode
     {
         Timer,
+        Benchmark,
         StopStepByStep,
-        AutoStepByStep
+        AutoStepByStep,
+        Web,
+        Portfolio
     };
 
     class PathFinder
     {
     private:
         
-        /// Hash function for the Coordinate, so a unordered map can be used for the obstacles
-        struct hash_pair {
-            size_t operator()(const Coordinate& p) const
-            {
-                auto hash1 = std::hash<int>{}(p.first);
-                auto hash2 = std::hash<int>{}(p.second);
-
-                if (hash1 != hash2)
-                {
-                    return hash1 ^ hash2;
-                }
-
-                return hash1;
-            }
-        };
-        
         /// Algorithm to run
         std::unique_ptr<AlgorithmBase> m_algorithm;
         
-        /// Collection of obstacles
-        std::unordered_map<Coordinate, bool, hash_pair> m_obstacles;
+        /// Algorithm raced on Portfolio mode, and whether its solutions are optimal
+        struct Racer
+        {
+            std::unique_ptr<AlgorithmBase> algorithm;
+            bool optimal;
+        };
+        
+        /// Algorithms raced on Portfolio mode
+        std::vector<Racer> m_racers;
+        
+        /// Only the solutions of the racers flagged as optimal are taken on Portfolio mode
+        bool m_firstOptimal = false;
+        
+        /// Algorithm of which the solution of the last run is reported, the winner of the race on Portfolio mode
+        AlgorithmBase* m_result = nullptr;
+        
+        /// Obstacles of the board, a bit per node with the same layout as the boards so they are copied in bulk
+        ObstacleGrid m_obstacles;
+        
+        /// Traversal costs of the board stored contiguously by axis, empty until a cost is set
+        std::vector<Cost> m_costs;
+        
+        /// Size of the board of the stored costs
+        Coordinate m_costsSize{ 0, 0 };
+        
+        /// Number of untimed runs before the timed ones on Benchmark mode
+        size_t m_warmups = 3;
+        
+        /// Number of timed runs on Benchmark mode
+        size_t m_repetitions = 30;
+        
+        /// Prints the board on the console after every run
+        bool m_consoleOutput = true;
+        
+        /// Columns and rows of the overview printed instead of the whole board, none if zero
+        Coordinate m_overviewSize{ 0, 0 };
+        
+        /// Magnification of the overview
+        double m_overviewZoom = 1.f;
+        
+        /// Path of the image written after every run, none if empty
+        std::string m_imagePath;
+        
+        /// Format of the image written after every run
+        ImageFormat m_imageFormat = ImageFormat::PPM;
+        
+        /// Size in pixels of the side of every node on the image
+        size_t m_imageScale = 1;
+        
+        /// Server of the viewer of the Web mode, if any
+        std::unique_ptr<WebOutput> m_webOutput;
+        
+        /// Pause between steps on Web mode
+        std::chrono::microseconds m_webStepDelay{ 0 };
+        
+#ifdef PATHFINDING_METRICS
+        /// Stream to which the metrics of every run are exported, if any
+        std::ostream* m_metricsOutput = nullptr;
+        
+        /// Format in which the metrics are exported
+        MetricsFormat m_metricsFormat = MetricsFormat::CSV;
+#endif
         
     public:
         
-        explicit PathFinder(std::unique_ptr<AlgorithmBase> &&algorithm = {}) : m_algorithm(std::move(algorithm))
+        explicit PathFinder(std::unique_ptr<AlgorithmBase> &&algorithm = {}) : m_algorithm(std::move(algorithm)), m_result(m_algorithm.get())
         {
             initObstacles();
+            initCosts();
         }
         
         /**
@@ -60,28 +114,68 @@ namespace PathFinding
         void setAlgorithm(std::unique_ptr<AlgorithmBase> &&algorithm)
         {
             m_algorithm = std::move(algorithm);
+            m_result = m_algorithm.get();
             
             initObstacles();
+            initCosts();
         }
         
         /**
-         * Returns a collection of random obstacles with size [0, total size / 2).
+         * Adds an algorithm to race on Portfolio mode, with the same obstacles and costs as the algorithm to run.
          *
-         * @return Collection of random obstacles.
+         * @param algorithm Algorithm to race, with a board of the same size as the algorithm to run.
+         * @param optimal Whether the solutions of the algorithm are optimal or not.
          */
-        auto getRandObstacles()
+        void addRacer(std::unique_ptr<AlgorithmBase> &&algorithm, const bool optimal = false)
         {
-            std::vector<Coordinate> obstacles;
-            
-            srand((unsigned int)time(0));
-            auto n = rand() % (m_algorithm.get()->getTotalSize() / 2);
-
-            for (size_t i = 0; i < n; ++i)
+            if (!algorithm || algorithm->getSize() != m_obstacles.getSize())
             {
-                Coordinate pos{rand() % m_algorithm.get()->getSize().first, rand() % m_algorithm.get()->getSize().second};
-                obstacles.emplace_back(pos);
+                std::cout << "Racers must have a board of the same size as the algorithm to run" << std::endl;
+                return;
             }
-            return obstacles;
+            
+            m_racers.push_back({ std::move(algorithm), optimal });
+        }
+        
+        /**
+         * Removes every algorithm raced on Portfolio mode.
+         */
+        void clearRacers()
+        {
+            m_result = m_algorithm.get();
+            m_racers.clear();
+        }
+        
+        /**
+         * Sets whether Portfolio mode takes the first solution found, or the first one of the racers flagged as optimal.
+         *
+         * @param firstOptimal Only the racers flagged as optimal are run.
+         */
+        void setFirstOptimal(const bool firstOptimal)
+        {
+            m_firstOptimal = firstOptimal;
+        }
+        
+        /**
+         * Returns the algorithm of which the solution of the last run is reported, the winner of the race on Portfolio mode.
+         *
+         * @return Algorithm of the last run.
+         */
+        const AlgorithmBase& getResult() const
+        {
+            return m_result ? *m_result : *m_algorithm;
+        }
+        
+        /**
+         * Sets the number of runs of the Benchmark mode.
+         *
+         * @param warmups Number of untimed runs before the timed ones.
+         * @param repetitions Number of timed runs.
+         */
+        void setBenchmarkRuns(const size_t warmups, const size_t repetitions)
+        {
+            m_warmups = warmups;
+            m_repetitions = std::max<size_t>(repetitions, 1);
         }
         
         /**
@@ -93,7 +187,11 @@ namespace PathFinding
         void setObstacle(const Coordinate& c, const bool obstacle = true)
         {
             m_algorithm.get()->setObstacle(c, obstacle);
-            m_obstacles[c] = obstacle;
+            
+            if (m_obstacles.isValid(c))
+            {
+                m_obstacles.set(c, obstacle);
+            }
         }
         
         /**
@@ -106,10 +204,98 @@ namespace PathFinding
         {
             for (auto c : cs)
             {
-                setObstacle(c);
+                setObstacle(c, obstacle);
             }
         }
         
+        /**
+         * Sets the traversal cost of the node at the coordinate given.
+         *
+         * @param c Coordinate in which the cost is modified.
+         * @param cost Cost of moving into the node.
+         */
+        void setCost(const Coordinate& c, const Cost cost = 1)
+        {
+            m_algorithm.get()->setCost(c, cost);
+            
+            if (m_obstacles.isValid(c))
+            {
+                if (m_costs.empty())
+                {
+                    m_costsSize = m_obstacles.getSize();
+                    m_costs.assign((size_t)m_costsSize.first * m_costsSize.second, 1);
+                }
+                m_costs[(size_t)c.first * m_costsSize.second + c.second] = cost;
+            }
+        }
+        
+#ifdef PATHFINDING_METRICS
+        /**
+         * Sets the stream to which the metrics of every run are exported.
+         *
+         * @param os Stream to which the metrics are exported.
+         * @param format Format in which the metrics are exported.
+         */
+        void setMetricsOutput(std::ostream& os, const MetricsFormat format = MetricsFormat::CSV)
+        {
+            m_metricsOutput = &os;
+            m_metricsFormat = format;
+            
+            Metrics::writeHeader(os, format);
+        }
+#endif
+        
+        /**
+         * Enables or disables printing the board on the console after every run, disable it to run headless.
+         *
+         * @param enabled Whether the board is printed or not.
+         */
+        void setConsoleOutput(const bool enabled)
+        {
+            m_consoleOutput = enabled;
+        }
+        
+        /**
+         * Prints an overview of the board after every run instead of the whole board, for boards bigger than the terminal.
+         *
+         * @param terminalSize Columns and rows available for the overview, zero to print the whole board again.
+         * @param zoom Magnification of the overview around the center of the board.
+         */
+        void setConsoleOverview(const Coordinate& terminalSize = { 80, 24 }, const double zoom = 1.f)
+        {
+            m_overviewSize = terminalSize;
+            m_overviewZoom = zoom;
+        }
+        
+        /**
+         * Sets the image file written after every run, streamed row by row so it works for boards too big for the console.
+         *
+         * @param path Path of the image, an empty path disables it.
+         * @param format Format of the image.
+         * @param scale Size in pixels of the side of every node.
+         */
+        void setImageOutput(const std::string& path, const ImageFormat format = ImageFormat::PPM, const size_t scale = 1)
+        {
+            m_imagePath = path;
+            m_imageFormat = format;
+            m_imageScale = scale;
+        }
+        
+        /**
+         * Serves a viewer on localhost, to which the Web mode streams the nodes changed on every step.
+         *
+         * @param port Port of localhost on which the viewer is served, open http://localhost:port/ to watch.
+         * @param stepDelay Pause between steps, so fast searches can be followed.
+         */
+        void setWebOutput(const unsigned short port = 8080, const std::chrono::microseconds stepDelay = std::chrono::microseconds(0))
+        {
+            m_webOutput = std::make_unique<WebOutput>(port);
+            m_webStepDelay = stepDelay;
+            
+            if (!m_webOutput->isServing())
+                std::cout << "Couldn't serve the viewer on port " << port << std::endl;
+        }
+        
         /**
          * Runs the algorithm with the parameters given.
          *
@@ -120,8 +306,15 @@ namespace PathFinding
          */
         void run(RunMode runMode = RunMode::Timer, Heuristic heuristic = Heuristic::Manhattan, bool diagonals = true, bool cutCorners = true)
         {
-            // Init the Algorithm
-            m_algorithm->init(heuristic, diagonals, cutCorners);
+            PATHFINDING_METRIC(auto phaseStart = std::chrono::steady_clock::now());
+            
+            // Init the Algorithm, the racers are inited when the race starts
+            m_result = m_algorithm.get();
+            if (runMode != RunMode::Portfolio)
+                m_algorithm->init(heuristic, diagonals, cutCorners);
+            
+            PATHFINDING_METRIC(m_algorithm->metrics.initTime = elapsedMicroseconds(phaseStart));
+            PATHFINDING_METRIC(phaseStart = std::chrono::steady_clock::now());
             
             switch (runMode)
             {
@@ -129,6 +322,10 @@ namespace PathFinding
                     runModeTimer();
                     break;
                     
+                case RunMode::Benchmark:
+                    runModeBenchmark(heuristic, diagonals, cutCorners);
+                    break;
+                    
                 case RunMode::StopStepByStep:
                     runModeStopStepByStep();
                     break;
@@ -137,29 +334,70 @@ namespace PathFinding
                     runModeAutoStepByStep();
                     break;
                     
+                case RunMode::Web:
+                    runModeWeb();
+                    break;
+                    
+                case RunMode::Portfolio:
+                    runModePortfolio(heuristic, diagonals, cutCorners);
+                    break;
+                    
                 default:
                     std::cout << "Mode not supported yet";
                     break;
             }
             
+            PATHFINDING_METRIC(m_result->metrics.searchTime = elapsedMicroseconds(phaseStart));
+            PATHFINDING_METRIC(exportMetrics());
+            
+            if (m_imagePath.size() && !ImageOutput::Write(*m_result, m_imagePath, m_imageFormat, m_imageScale))
+            {
+                std::cout << "Couldn't write the image " << m_imagePath << std::endl;
+            }
+            
             // Print the solution if there is any
-            ConsoleOutput::Print(*m_algorithm, true, true);
+            if (m_consoleOutput && m_overviewSize.first > 0 && m_overviewSize.second > 0)
+            {
+                ConsoleOutput::PrintOverview(*m_result, m_overviewSize, m_overviewZoom, { -1, -1 }, true);
+            }
+            else if (m_consoleOutput)
+            {
+                ConsoleOutput::Print(*m_result, true, true);
+            }
         }
         
         /**
-         * Sets random obstacles.
+         * Sets random obstacles, with a random density in [0, 0.5).
          *
          * @param resetBefore Resets the obstacles before setting them randomly.
+         * @param seed Seed of the random generator, so the obstacles can be reproduced.
          */
-        void setRandObstacles(bool resetBefore = true)
+        void setRandObstacles(bool resetBefore = true, const unsigned int seed = (unsigned int)time(0))
         {
+            setGeneratedObstacles(ObstaclePattern::Uniform, seed, RandomGenerator(seed).nextDouble() * 0.5, resetBefore);
+        }
+        
+        /**
+         * Sets the obstacles generated with the pattern given, written in bulk into the board.
+         *
+         * @param pattern Layout of the obstacles.
+         * @param seed Seed of the random generator, so the obstacles can be reproduced.
+         * @param density Density of the obstacles, its meaning depends on the pattern.
+         * @param resetBefore Resets the obstacles before setting the generated ones.
+         */
+        void setGeneratedObstacles(const ObstaclePattern pattern, const std::uint64_t seed, const double density = 0.3, bool resetBefore = true)
+        {
+            auto grid = ObstacleGenerator::Generate(pattern, m_algorithm->getSize(), seed, density);
+            
             if (resetBefore)
             {
                 m_algorithm.get()->reset();
                 resetObstacles();
             }
             
-            setObstacles(getRandObstacles());
+            // Keep the obstacles already set, if any
+            m_obstacles |= grid;
+            m_algorithm.get()->setObstacles(m_obstacles);
         }
         
     private:
@@ -176,16 +414,60 @@ namespace PathFinding
             }
         }
         
+        /**
+         * Runs the Algorithm on Benchmark mode, repeating it over the same obstacles and reporting the statistics.
+         *
+         * @param heuristic Heuristic to use when calculating distances.
+         * @param diagonals The algorithm can use diagonal movements.
+         * @param cutCorners The algorithm can cut corners when passing next to an obstacle.
+         */
+        void runModeBenchmark(Heuristic heuristic, bool diagonals, bool cutCorners)
+        {
+            // Untimed runs, so the caches and the branch predictor are warm
+            for (size_t i = 0; i < m_warmups; ++i)
+            {
+                m_algorithm->init(heuristic, diagonals, cutCorners);
+                m_algorithm->complete();
+            }
+            
+            std::vector<double> samples;
+            samples.reserve(m_repetitions);
+            
+            Benchmark::Stopwatch stopwatch;
+            for (size_t i = 0; i < m_repetitions; ++i)
+            {
+                m_algorithm->init(heuristic, diagonals, cutCorners);
+                
+                stopwatch.Restart();
+                m_algorithm->complete();
+                samples.push_back(stopwatch.Elapsed());
+            }
+            
+            const Benchmark::Statistics stats(std::move(samples));
+            const auto expansions = stats.median > 0 ? m_algorithm->nodesClosed / (stats.median * 0.000001) : 0.f;
+            
+            std::cout << "Benchmark: " << m_algorithm->name << " - " << stats.count << " runs (" << m_warmups << " warmups)" << std::endl;
+            std::cout << "min: " << stats.min << "us - median: " << stats.median << "us - p95: " << stats.p95
+                      << "us - p99: " << stats.p99 << "us - stddev: " << stats.stddev << "us" << std::endl;
+            std::cout << "Expansions per second: " << expansions << std::endl;
+        }
+        
         /**
          * Runs the Algorithm on StopStepByStep mode.
          */
         void runModeStopStepByStep()
         {
+            // Draw the whole board once, and then only the nodes changed on every step
+            m_algorithm->trackChanges = true;
+            ConsoleOutput::Redraw(*m_algorithm);
+            
             // Execute the algorithm with stops between steps
             while (!m_algorithm->nextStep())
             {
-                ConsoleOutput::Print(*m_algorithm, true, true);
+                ConsoleOutput::RedrawChanges(*m_algorithm, true);
             }
+            
+            m_algorithm->trackChanges = false;
         }
         
         /**
@@ -193,23 +475,181 @@ namespace PathFinding
          */
         void runModeAutoStepByStep()
         {
+            // Draw the whole board once, and then only the nodes changed on every step
+            m_algorithm->trackChanges = true;
+            ConsoleOutput::Redraw(*m_algorithm);
+            
             // Execute the algorithm with 500ms stops between steps
             while (!m_algorithm->nextStep())
             {
-                ConsoleOutput::Print(*m_algorithm);
+                ConsoleOutput::RedrawChanges(*m_algorithm);
                 std::this_thread::sleep_for(std::chrono::milliseconds(500));
             }
+            
+            m_algorithm->trackChanges = false;
+        }
+        
+        /**
+         * Runs the Algorithm on Web mode, streaming every step to the viewer.
+         */
+        void runModeWeb()
+        {
+            if (!m_webOutput || !m_webOutput->isServing())
+            {
+                std::cout << "Web output not set, call setWebOutput first" << std::endl;
+                return;
+            }
+            
+            // Stream the whole board once, and then only the nodes changed on every step
+            m_algorithm->trackChanges = true;
+            m_webOutput->begin(*m_algorithm);
+            
+            for (bool finished = false; !finished;)
+            {
+                finished = m_algorithm->nextStep();
+                m_webOutput->publish(*m_algorithm);
+                
+                if (m_webStepDelay.count())
+                    std::this_thread::sleep_for(m_webStepDelay);
+            }
+            
+            m_algorithm->trackChanges = false;
         }
         
         /**
-         * Init the obstacles of the Algorithm with the ones stored.
+         * Runs the racers on Portfolio mode, each one on its own thread, and takes the first solution found cancelling the rest.
+         *
+         * @param heuristic Heuristic to use when calculating distances.
+         * @param diagonals The algorithm can use diagonal movements.
+         * @param cutCorners The algorithm can cut corners when passing next to an obstacle.
+         */
+        void runModePortfolio(Heuristic heuristic, bool diagonals, bool cutCorners)
+        {
+            std::vector<Racer*> racers;
+            for (auto& racer : m_racers)
+            {
+                if (m_firstOptimal && !racer.optimal) continue;
+                
+                // The algorithm to run may have been changed to one of another size after the racer was added
+                if (racer.algorithm->getSize() != m_obstacles.getSize())
+                {
+                    std::cout << "Skipping racer " << racer.algorithm->name << ", its board is not of the same size as the algorithm to run" << std::endl;
+                    continue;
+                }
+                
+                racers.push_back(&racer);
+            }
+            
+            if (racers.empty())
+            {
+                std::cout << "No racers to run, call addRacer first" << std::endl;
+                return;
+            }
+            
+            // Every racer searches the obstacles and costs stored, copied in bulk into its board
+            std::vector<std::unique_ptr<SearchTask>> tasks;
+            for (auto* racer : racers)
+            {
+                racer->algorithm->setObstacles(m_obstacles);
+                if (m_costs.size())
+                    racer->algorithm->setCosts(m_costs);
+                
+                tasks.push_back(std::make_unique<SearchTask>(*racer->algorithm, heuristic, diagonals, cutCorners));
+            }
+            
+            std::atomic<size_t> winner{ racers.size() };
+            
+            // We create this scope to make the timer call its destructor
+            {
+                Benchmark::Timer timer("Portfolio");
+                
+                std::vector<std::thread> threads;
+                for (size_t i = 0; i < tasks.size(); ++i)
+                {
+                    threads.emplace_back([&tasks, &winner, i]()
+                    {
+                        if (tasks[i]->run() != SearchStatus::Found) return;
+                        
+                        // Only the first racer to find a solution wins, and stops the rest
+                        auto none = tasks.size();
+                        if (!winner.compare_exchange_strong(none, i)) return;
+                        
+                        for (auto& task : tasks)
+                        {
+                            task->cancel();
+                        }
+                    });
+                }
+                
+                for (auto& thread : threads)
+                {
+                    thread.join();
+                }
+            }
+            
+            m_result = racers[winner < racers.size() ? (size_t)winner : 0]->algorithm.get();
+            std::cout << "Portfolio: " << (winner < racers.size() ? m_result->name + " won" : "no solution found") << std::endl;
+        }
+        
+#ifdef PATHFINDING_METRICS
+        /**
+         * Calculates the wall time elapsed since the time point given.
+         *
+         * @param start Time point from which the time is measured.
+         * @return Wall time elapsed, in microseconds.
+         */
+        static double elapsedMicroseconds(const std::chrono::steady_clock::time_point& start)
+        {
+            return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        }
+        
+        /**
+         * Exports the metrics of the last run, if an output is set.
+         */
+        void exportMetrics() const
+        {
+            if (!m_metricsOutput) return;
+            
+            m_result->metrics.write(*m_metricsOutput, m_metricsFormat, m_result->name,
+                                    m_result->nodesOpened, m_result->nodesClosed);
+        }
+#endif
+        
+        /**
+         * Init the obstacles of the Algorithm with the ones stored, adapting them to the size of its board.
          */
         void initObstacles()
         {
-            for (auto& c: m_obstacles)
+            if (!m_algorithm) return;
+            
+            m_obstacles.resize(m_algorithm->getSize());
+            m_algorithm.get()->setObstacles(m_obstacles);
+        }
+        
+        /**
+         * Init the costs of the Algorithm with the ones stored, adapting them to the size of its board.
+         */
+        void initCosts()
+        {
+            if (!m_algorithm || m_costs.empty()) return;
+            
+            const auto size = m_algorithm->getSize();
+            if (size != m_costsSize)
             {
-                m_algorithm.get()->setObstacle(c.first);
+                // Keep the costs of the area shared by both sizes
+                std::vector<Cost> costs((size_t)size.first * size.second, 1);
+                for (int i = 0; i < std::min(size.first, m_costsSize.first); ++i)
+                {
+                    for (int j = 0; j < std::min(size.second, m_costsSize.second); ++j)
+                    {
+                        costs[(size_t)i * size.second + j] = m_costs[(size_t)i * m_costsSize.second + j];
+                    }
+                }
+                m_costs = std::move(costs);
+                m_costsSize = size;
             }
+            
+            m_algorithm.get()->setCosts(m_costs);
         }
         
         /**
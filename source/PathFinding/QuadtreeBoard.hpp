@@ -0,0 +1,515 @@
+#ifndef QUADTREE_BOARD_H
+#define QUADTREE_BOARD_H
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "Board.hpp"
+
+
+namespace PathFinding
+{
+    /// Square block of free nodes with the same cost, a leaf of the quadtree of the board
+    struct QuadBlock
+    {
+        /// Position of the node of the block with the lowest coordinates
+        Coordinate position{ 0, 0 };
+
+        /// Number of nodes of the side of the block, 0 if the block is not used
+        int side = 0;
+
+        /// Traversal cost of every node of the block
+        Cost cost = 1;
+    };
+
+    /// Board decomposed in the maximal square blocks of free nodes with the same cost of a quadtree, so the open areas are
+    /// searched as a few blocks instead of node by node. The obstacles and costs are still stored by node, and the blocks
+    /// are updated locally when they change: the block of the node changed is decomposed again and merged upwards
+    class QuadtreeBoard
+    {
+    public:
+        /// Index of the block of an obstacle
+        static constexpr std::uint32_t None = std::numeric_limits<std::uint32_t>::max();
+
+        /// Offset of every direction, in the same order as the neighbors of Board
+        static constexpr std::array<Coordinate, 8> Directions{{
+            { 0, -1 }, { 1, 0 }, { 0, 1 }, { -1, 0 },       // North, East, South, West
+            { -1, -1 }, { 1, -1 }, { 1, 1 }, { -1, 1 }      // North West, North East, South East, South West
+        }};
+
+    private:
+        /// Size of the board by axis
+        const Coordinate m_size;
+
+        /// Total size of the board
+        const size_t m_totalSize;
+
+        /// Position of the start node
+        const Coordinate m_start;
+
+        /// Position of the goal node
+        const Coordinate m_goal;
+
+        /// Number of nodes of the side of the root of the quadtree, a power of two that covers the board
+        const int m_side;
+
+        /// Whether every node of the board is an obstacle or not
+        ObstacleGrid m_obstacles;
+
+        /// Traversal cost of every node of the board, stored contiguously by axis
+        std::vector<Cost> m_costs;
+
+        /// Number of nodes of the board with each cost, used to keep the minimum cost updated
+        std::array<size_t, 256> m_costCount{};
+
+        /// Minimum traversal cost of the board
+        Cost m_minCost = 1;
+
+        /// Collection of all blocks, including the ones not used any more
+        std::vector<QuadBlock> m_blocks;
+
+        /// Indexes of the blocks not used any more, to reuse them
+        std::vector<std::uint32_t> m_unusedBlocks;
+
+        /// Index of the block of every node, stored contiguously by axis
+        std::vector<std::uint32_t> m_nodeBlocks;
+
+    public:
+        /**
+         * Create a board with the size, start, and goal position given, without obstacles
+         *
+         * @param size Size of the board, of less than 2^32 nodes
+         * @param start Start position of the board
+         * @param goal Goal position of the board
+         */
+        QuadtreeBoard(const Coordinate& size, const Coordinate& start, const Coordinate& goal)
+            : m_size(size), m_totalSize((size_t)size.first * size.second), m_start(start), m_goal(goal),
+              m_side((int)std::bit_ceil((std::uint32_t)std::max({ size.first, size.second, 1 }))), m_obstacles(size),
+              m_costs(m_totalSize, 1), m_nodeBlocks(m_totalSize, None)
+        {
+            m_costCount[1] = m_totalSize;
+            decompose({ 0, 0 }, m_side);
+        }
+
+        /**
+         * Removes every obstacle, keeping the costs
+         */
+        void reset()
+        {
+            m_obstacles.clear();
+            rebuild();
+        }
+
+        inline size_t getTotalSize() const { return m_totalSize; }
+
+        /**
+         * Returns the number of blocks used
+         *
+         * @return Number of blocks used
+         */
+        inline size_t getBlockCount() const { return m_blocks.size() - m_unusedBlocks.size(); }
+
+        /**
+         * Returns the number of indexes of blocks, including the ones not used any more
+         *
+         * @return Number of indexes of blocks
+         */
+        inline size_t getBlockCapacity() const { return m_blocks.size(); }
+
+        inline const QuadBlock& getBlock(const std::uint32_t block) const { return m_blocks[block]; }
+
+        /**
+         * Returns the block of a valid coordinate
+         *
+         * @param c Coordinate of the node
+         * @return Index of the block, None if the node is an obstacle
+         */
+        inline std::uint32_t getBlockOf(const Coordinate& c) const { return m_nodeBlocks[getIndex(c)]; }
+
+        /**
+         * Get the approximate memory used by the board
+         *
+         * @return The approximate memory used by the board, in bytes
+         */
+        size_t getMemoryUsage() const
+        {
+            return m_size.first * m_obstacles.getColumnWords() * sizeof(BitGrid::Word) + m_totalSize * (sizeof(Cost) + sizeof(std::uint32_t))
+                + m_blocks.capacity() * sizeof(QuadBlock) + m_unusedBlocks.capacity() * sizeof(std::uint32_t);
+        }
+
+        inline const Coordinate getSize() const { return m_size; }
+
+        inline const Coordinate getStart() const { return m_start; }
+
+        inline const Coordinate getGoal() const { return m_goal; }
+
+        inline const bool isValidNode(const Coordinate& c) const
+        {
+            return c.first >= 0 && c.first < m_size.first && c.second >= 0 && c.second < m_size.second;
+        }
+
+        inline const bool isObstacle(const Coordinate& c) const
+        {
+            return isValidNode(c) && m_obstacles.test(c);
+        }
+
+        /**
+         * Sets the node at the coordinate given as an obstacle or not, except the start and the goal, updating its blocks
+         *
+         * @param c Coordinate in which the obstacle field is modified
+         * @param obstacle Wether we set it to be an obstacle or not
+         */
+        void setObstacle(const Coordinate& c, const bool obstacle = true)
+        {
+            if (!isValidNode(c) || c == m_start || c == m_goal || m_obstacles.test(c) == obstacle) return;
+
+            m_obstacles.set(c, obstacle);
+            update(c);
+        }
+
+        /**
+         * Sets every node of the board as an obstacle or not from a grid of the same size, except the start and the goal,
+         * decomposing the whole board again
+         *
+         * @param obstacles Grid with a bit per node
+         */
+        void setObstacles(const ObstacleGrid& obstacles)
+        {
+            if (obstacles.getSize() != m_size) return;
+
+            m_obstacles = obstacles;
+
+            // The start and the goal can't be obstacles
+            if (isValidNode(m_start)) m_obstacles.set(m_start, false);
+            if (isValidNode(m_goal)) m_obstacles.set(m_goal, false);
+
+            rebuild();
+        }
+
+        inline const Cost getCost(const Coordinate& c) const
+        {
+            return isValidNode(c) ? m_costs[getIndex(c)] : 1;
+        }
+
+        /**
+         * Sets the traversal cost of the node at the coordinate given, updating its blocks. Costs are terrain data, so
+         * they are kept on reset
+         *
+         * @param c Coordinate in which the cost is modified
+         * @param cost Cost of moving into the node, at least 1
+         */
+        void setCost(const Coordinate& c, const Cost cost = 1)
+        {
+            if (!isValidNode(c)) return;
+
+            auto& current = m_costs[getIndex(c)];
+            const Cost next = std::max<Cost>(cost, 1);
+            if (current == next) return;
+
+            --m_costCount[current];
+            ++m_costCount[next];
+            current = next;
+
+            // Only look for the new minimum if it could have changed
+            if (next < m_minCost)
+            {
+                m_minCost = next;
+            }
+            else if (!m_costCount[m_minCost])
+            {
+                while (!m_costCount[m_minCost]) ++m_minCost;
+            }
+
+            if (!m_obstacles.test(c)) update(c);
+        }
+
+        /**
+         * Sets the traversal cost of every node of the board from a collection of the same size, decomposing the whole
+         * board again
+         *
+         * @param costs Collection with the cost of every node, stored contiguously by axis
+         */
+        void setCosts(const std::vector<Cost>& costs)
+        {
+            if (costs.size() != m_totalSize) return;
+
+            m_costCount.fill(0);
+            for (size_t i = 0; i < m_totalSize; ++i)
+            {
+                m_costs[i] = std::max<Cost>(costs[i], 1);
+                ++m_costCount[m_costs[i]];
+            }
+
+            for (m_minCost = 1; m_minCost < m_costCount.size() - 1 && !m_costCount[m_minCost]; ++m_minCost);
+
+            rebuild();
+        }
+
+        inline const Cost getMinCost() const { return m_minCost; }
+
+        /**
+         * Adds the blocks that share part of a side with the block given to the collection given. Blocks touching only
+         * by a corner are not neighbors, so there is always an orthogonal move between neighbor blocks
+         *
+         * @param block Index of the block from which the neighbors are returned
+         * @param neighbors Reference to the collection of neighbors to which they are added
+         */
+        void getNeighborBlocks(const std::uint32_t block, std::vector<std::uint32_t>& neighbors) const
+        {
+            const auto& [position, side, cost] = m_blocks[block];
+
+            // Walk the nodes next to every side, skipping the rest of the side of every block found
+            for (const int x : { position.first - 1, position.first + side })
+            {
+                if (x < 0 || x >= m_size.first) continue;
+
+                for (int y = position.second; y < position.second + side; )
+                {
+                    const auto neighbor = m_nodeBlocks[getIndex({ x, y })];
+                    if (neighbor == None) { ++y; continue; }
+
+                    neighbors.push_back(neighbor);
+                    y = m_blocks[neighbor].position.second + m_blocks[neighbor].side;
+                }
+            }
+
+            for (const int y : { position.second - 1, position.second + side })
+            {
+                if (y < 0 || y >= m_size.second) continue;
+
+                for (int x = position.first; x < position.first + side; )
+                {
+                    const auto neighbor = m_nodeBlocks[getIndex({ x, y })];
+                    if (neighbor == None) { ++x; continue; }
+
+                    neighbors.push_back(neighbor);
+                    x = m_blocks[neighbor].position.first + m_blocks[neighbor].side;
+                }
+            }
+        }
+
+        /**
+         * Adds the accessible neighbors with the moves allowed, choosing the neighbor generator of the moves once per call
+         *
+         * @param c Coordinate of the node from which the neighbors are returned
+         * @param neighbors Reference to the collection of neighbors to which they are added
+         * @param movement Moves allowed between neighbor nodes
+         */
+        void getNeighbors(const Coordinate& c, std::vector<Coordinate>& neighbors, const Movement movement) const
+        {
+            switch (movement)
+            {
+                case Movement::Orthogonal:
+                    return getNeighbors<Movement::Orthogonal>(c, neighbors);
+
+                case Movement::Diagonal:
+                    return getNeighbors<Movement::Diagonal>(c, neighbors);
+
+                case Movement::DiagonalNoCornerCut:
+                    return getNeighbors<Movement::DiagonalNoCornerCut>(c, neighbors);
+            }
+        }
+
+        /**
+         * Adds the coordinates of the accessible neighbor nodes to the collection given, in the same order as the
+         * neighbors of Board
+         *
+         * @param c Coordinate of the node from which the neighbors are returned
+         * @param neighbors Reference to the collection of neighbors to which they are added
+         */
+        template <Movement M>
+        void getNeighbors(const Coordinate& c, std::vector<Coordinate>& neighbors) const
+        {
+            // Whether every orthogonal neighbor is accessible, to check the corners of the diagonal ones
+            bool accessible[4];
+            for (size_t i = 0; i < 4; ++i)
+            {
+                const Coordinate to{ c.first + Directions[i].first, c.second + Directions[i].second };
+
+                accessible[i] = isValidNode(to) && !m_obstacles.test(to);
+                if (accessible[i]) neighbors.push_back(to);
+            }
+
+            if constexpr (M == Movement::Orthogonal) return;
+
+            for (size_t i = 4; i < 8; ++i)
+            {
+                const Coordinate to{ c.first + Directions[i].first, c.second + Directions[i].second };
+                if (!isValidNode(to) || m_obstacles.test(to)) continue;
+
+                const bool contiguous1 = accessible[Directions[i].second < 0 ? 0 : 2];
+                const bool contiguous2 = accessible[Directions[i].first > 0 ? 1 : 3];
+                if (!IsDiagonalAllowed<M>(contiguous1, contiguous2)) continue;
+
+                neighbors.push_back(to);
+            }
+        }
+
+    private:
+        inline size_t getIndex(const Coordinate& c) const { return (size_t)c.first * m_size.second + c.second; }
+
+        /**
+         * Checks if the square given is inside the board, and every node of it is free with the same cost
+         *
+         * @param position Position of the node of the square with the lowest coordinates
+         * @param side Number of nodes of the side of the square
+         * @return Whether the square can be a single block
+         */
+        bool isUniform(const Coordinate& position, const int side) const
+        {
+            if (position.first + side > m_size.first || position.second + side > m_size.second) return false;
+
+            const Cost cost = m_costs[getIndex(position)];
+            for (int i = position.first; i < position.first + side; ++i)
+            {
+                for (int j = position.second; j < position.second + side; ++j)
+                {
+                    if (m_obstacles.test({ i, j }) || m_costs[getIndex({ i, j })] != cost) return false;
+                }
+            }
+            return true;
+        }
+
+        /**
+         * Splits a square of the quadtree in the maximal blocks of free nodes with the same cost
+         *
+         * @param position Position of the node of the square with the lowest coordinates
+         * @param side Number of nodes of the side of the square
+         */
+        void decompose(const Coordinate& position, const int side)
+        {
+            if (position.first >= m_size.first || position.second >= m_size.second) return;
+
+            if (isUniform(position, side))
+            {
+                addBlock(position, side);
+                return;
+            }
+
+            if (side == 1) return;
+
+            const int half = side / 2;
+            decompose(position, half);
+            decompose({ position.first + half, position.second }, half);
+            decompose({ position.first, position.second + half }, half);
+            decompose({ position.first + half, position.second + half }, half);
+        }
+
+        /**
+         * Removes every block and decomposes the whole board again
+         */
+        void rebuild()
+        {
+            m_blocks.clear();
+            m_unusedBlocks.clear();
+            std::fill(m_nodeBlocks.begin(), m_nodeBlocks.end(), None);
+            decompose({ 0, 0 }, m_side);
+        }
+
+        /**
+         * Updates the blocks after the obstacle or the cost of a node changed, decomposing its block again and merging
+         * the block of the node with its siblings while they are blocks of its size and cost
+         *
+         * @param c Coordinate of the node changed
+         */
+        void update(const Coordinate& c)
+        {
+            const auto block = m_nodeBlocks[getIndex(c)];
+            if (block != None)
+            {
+                const auto [position, side, cost] = m_blocks[block];
+                removeBlock(block);
+                decompose(position, side);
+            }
+            else if (!m_obstacles.test(c))
+            {
+                addBlock(c, 1);
+            }
+
+            if (m_nodeBlocks[getIndex(c)] != None) merge(m_nodeBlocks[getIndex(c)]);
+        }
+
+        /**
+         * Merges a block with its siblings of the quadtree while they are blocks of the same size and cost
+         *
+         * @param block Index of the block
+         */
+        void merge(std::uint32_t block)
+        {
+            while (m_blocks[block].side < m_side)
+            {
+                const auto [position, side, cost] = m_blocks[block];
+                const Coordinate parent{ position.first & ~(2 * side - 1), position.second & ~(2 * side - 1) };
+                if (parent.first + 2 * side > m_size.first || parent.second + 2 * side > m_size.second) return;
+
+                std::array<std::uint32_t, 4> siblings;
+                for (int i = 0; i < 4; ++i)
+                {
+                    const Coordinate sibling{ parent.first + (i & 1) * side, parent.second + (i >> 1) * side };
+                    siblings[i] = m_nodeBlocks[getIndex(sibling)];
+
+                    if (siblings[i] == None || m_blocks[siblings[i]].side != side || m_blocks[siblings[i]].position != sibling
+                        || m_blocks[siblings[i]].cost != cost) return;
+                }
+
+                for (const auto sibling : siblings)
+                {
+                    removeBlock(sibling);
+                }
+                block = addBlock(parent, 2 * side);
+            }
+        }
+
+        /**
+         * Adds a block and sets it as the block of its nodes
+         *
+         * @param position Position of the node of the block with the lowest coordinates
+         * @param side Number of nodes of the side of the block
+         * @return Index of the block
+         */
+        std::uint32_t addBlock(const Coordinate& position, const int side)
+        {
+            std::uint32_t block;
+            if (m_unusedBlocks.size())
+            {
+                block = m_unusedBlocks.back();
+                m_unusedBlocks.pop_back();
+            }
+            else
+            {
+                block = (std::uint32_t)m_blocks.size();
+                m_blocks.emplace_back();
+            }
+
+            m_blocks[block] = { position, side, m_costs[getIndex(position)] };
+            for (int i = position.first; i < position.first + side; ++i)
+            {
+                std::fill_n(m_nodeBlocks.begin() + getIndex({ i, position.second }), side, block);
+            }
+            return block;
+        }
+
+        /**
+         * Removes a block, leaving its nodes without block until they are decomposed or merged again
+         *
+         * @param block Index of the block
+         */
+        void removeBlock(const std::uint32_t block)
+        {
+            const auto& [position, side, cost] = m_blocks[block];
+            for (int i = position.first; i < position.first + side; ++i)
+            {
+                std::fill_n(m_nodeBlocks.begin() + getIndex({ i, position.second }), side, None);
+            }
+
+            m_blocks[block].side = 0;
+            m_unusedBlocks.push_back(block);
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,157 @@
+#ifndef SEARCH_TASK_H
+#define SEARCH_TASK_H
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <limits>
+#include "Algorithms/AlgorithmBase.hpp"
+
+
+namespace PathFinding
+{
+    /// Status of a search
+    enum class SearchStatus
+    {
+        Running,
+        Found,
+        NotFound,
+        Cancelled,
+        DeadlineExceeded
+    };
+
+    /// Search that can be spread over several time slices, run on a worker thread, cancelled and given a deadline.
+    /// The algorithm must not be used by anyone else until the search is no longer running
+    class SearchTask
+    {
+    public:
+        typedef std::chrono::steady_clock                   clock;
+        typedef clock::time_point                           time_point;
+
+    private:
+        /// Steps between every check of the clock, so reading it doesn't slow down the steps
+        static const size_t m_clockSteps = 32;
+
+        /// Algorithm searching
+        AlgorithmBase& m_algorithm;
+
+        /// Time point after which the search stops, if any
+        time_point m_deadline;
+
+        /// Set from any thread to stop the search on its next check
+        std::atomic<bool> m_cancelled{ false };
+
+        /// Status of the search, written by the thread running it
+        std::atomic<SearchStatus> m_status{ SearchStatus::Running };
+
+    public:
+        /**
+         * Inits the algorithm with the parameters given, without running any step yet
+         *
+         * @param algorithm Algorithm to run
+         * @param heuristic Heuristic to use when calculating distances
+         * @param diagonals The algorithm can use diagonal movements
+         * @param cutCorners The algorithm can cut corners when passing next to an obstacle
+         * @param deadline Time point after which the search stops, none by default
+         */
+        SearchTask(AlgorithmBase& algorithm, const Heuristic heuristic, const bool diagonals = true, const bool cutCorners = true,
+                   const time_point deadline = time_point::max())
+            : m_algorithm(algorithm), m_deadline(deadline)
+        {
+            m_algorithm.init(heuristic, diagonals, cutCorners);
+        }
+
+        SearchTask(const SearchTask&) = delete;
+        SearchTask& operator=(const SearchTask&) = delete;
+
+        /**
+         * Runs the steps that fit in the budget given and returns, so a long search can be spread over several frames
+         *
+         * @param budget Maximum time to run, checked on the first, the last and every few steps, so it can be slightly exceeded. No limit if max
+         * @param maxSteps Maximum number of steps to run
+         * @return Status of the search after the slice
+         */
+        SearchStatus runSlice(const std::chrono::microseconds budget, const size_t maxSteps = std::numeric_limits<size_t>::max())
+        {
+            if (m_status != SearchStatus::Running) return m_status;
+
+            const auto sliceEnd = budget == std::chrono::microseconds::max() ? time_point::max() : clock::now() + budget;
+
+            for (size_t step = 0; step < maxSteps; ++step)
+            {
+                if (m_algorithm.nextStep())
+                {
+                    return m_status = m_algorithm.hasSolution() ? SearchStatus::Found : SearchStatus::NotFound;
+                }
+
+                // The clock is also checked on the first and the last step, so short slices still honor the deadline
+                if (step == 0 || step + 1 == maxSteps || step % m_clockSteps == m_clockSteps - 1)
+                {
+                    if (m_cancelled)
+                        return m_status = SearchStatus::Cancelled;
+
+                    const auto now = clock::now();
+                    if (now >= m_deadline)
+                        return m_status = SearchStatus::DeadlineExceeded;
+
+                    else if (now >= sliceEnd)
+                        break;
+                }
+            }
+
+            if (m_cancelled)
+                return m_status = SearchStatus::Cancelled;
+
+            return m_status;
+        }
+
+        /**
+         * Runs the search until it finishes, it is cancelled or the deadline is reached
+         *
+         * @return Final status of the search
+         */
+        SearchStatus run()
+        {
+            return runSlice(std::chrono::microseconds::max());
+        }
+
+        /**
+         * Runs the search on a worker thread. The task must outlive the worker, the future waits for it when destroyed
+         *
+         * @return Future with the final status of the search
+         */
+        std::future<SearchStatus> runAsync()
+        {
+            return std::async(std::launch::async, [this]() { return run(); });
+        }
+
+        /**
+         * Asks the search to stop, from any thread. It stops within a few steps
+         */
+        inline void cancel() { m_cancelled = true; }
+
+        /**
+         * Returns the status of the search
+         *
+         * @return Status of the search
+         */
+        inline const SearchStatus getStatus() const { return m_status; }
+
+        /**
+         * Checks if the search is finished, for any reason
+         *
+         * @return If the search is finished
+         */
+        inline const bool isFinished() const { return m_status != SearchStatus::Running; }
+
+        /**
+         * Returns the algorithm searching, only to be used once the search is finished
+         *
+         * @return Algorithm searching
+         */
+        inline AlgorithmBase& getAlgorithm() { return m_algorithm; }
+    };
+}
+
+#endif
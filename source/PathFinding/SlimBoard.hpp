@@ -0,0 +1,356 @@
+#ifndef SLIM_BOARD_H
+#define SLIM_BOARD_H
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "Board.hpp"
+#include "BoardLayout.hpp"
+
+
+namespace PathFinding
+{
+    /// Node without virtual functions nor position, 8 bytes. The position is derived from its index on the board, the
+    /// parent is an index too and the obstacle, opened and closed states are packed in a byte
+    struct SlimNode
+    {
+        /// Index of a node without parent
+        static const std::uint32_t None = std::numeric_limits<std::uint32_t>::max();
+
+        /// States of the node packed in its flags
+        enum Flag : std::uint8_t
+        {
+            Obstacle = 1,
+            Opened = 2,
+            Closed = 4
+        };
+
+        /// Index of the previous node from which the shortest path reaches this node
+        std::uint32_t parent = None;
+
+        /// States of the node
+        std::uint8_t flags = 0;
+
+        inline bool is(const Flag flag) const { return flags & flag; }
+
+        inline void set(const Flag flag, const bool value = true) { flags = value ? flags | flag : flags & ~flag; }
+    };
+
+    /// Board of slim nodes stored contiguously in the layout chosen on construction, for boards too big for the nodes of
+    /// Board. Nodes are reset by assigning a default node, so the nodes derived from SlimNode only need default member values
+    template <Derived<SlimNode>T>
+    class SlimBoard
+    {
+    private:
+        /// Size of the board by axis
+        const Coordinate m_size;
+
+        /// Total size of the board
+        const size_t m_totalSize;
+
+        /// Position of the start node
+        const Coordinate m_start;
+
+        /// Position of the goal node
+        const Coordinate m_goal;
+
+        /// Mapping of the coordinates to the indexes of the nodes
+        const LayoutIndexer m_layout;
+
+        /// Collection of all nodes of the board, including the padding of the layout
+        std::vector<T> m_nodes;
+
+        /// Traversal cost of every node of the board, in the same layout as the nodes
+        std::vector<Cost> m_costs;
+
+        /// Number of nodes of the board with each cost, used to keep the minimum cost updated
+        std::array<size_t, 256> m_costCount{};
+
+        /// Minimum traversal cost of the board
+        Cost m_minCost = 1;
+
+    public:
+        /**
+         * Create a board with the size, start, and goal position given
+         *
+         * @param size Size of the board, of less than 2^32 nodes
+         * @param start Start position of the board
+         * @param goal Goal position of the board
+         * @param layout Order of the nodes on memory, the linear one is used instead if its padding doesn't fit in 32 bits
+         */
+        SlimBoard(const Coordinate& size, const Coordinate& start, const Coordinate& goal, const BoardLayout layout = BoardLayout::Linear)
+            : m_size(size), m_totalSize((size_t)size.first * size.second), m_start(start), m_goal(goal), m_layout(CreateLayout(size, layout)),
+              m_nodes(m_layout.getCapacity()), m_costs(m_layout.getCapacity(), 1)
+        {
+            m_costCount[1] = m_totalSize;
+        }
+
+        /**
+         * Creates the mapping of the layout given, or of the linear one if the indexes of the layout given, padding included,
+         * don't fit in 32 bits without reaching None. A Morton layout of 65536x65536 nodes or more, after padding, doesn't
+         *
+         * @param size Size of the board by axis
+         * @param layout Order of the nodes on memory
+         * @return Mapping of the coordinates to the indexes of the nodes
+         */
+        static LayoutIndexer CreateLayout(const Coordinate& size, const BoardLayout layout)
+        {
+            LayoutIndexer indexer(size, layout);
+            return indexer.getCapacity() <= SlimNode::None ? indexer : LayoutIndexer(size, BoardLayout::Linear);
+        }
+
+        /**
+         * Resets every node of the board, keeping the obstacles
+         */
+        void init()
+        {
+            for (auto& node : m_nodes)
+            {
+                const bool obstacle = node.is(SlimNode::Obstacle);
+                node = T();
+                node.set(SlimNode::Obstacle, obstacle);
+            }
+        }
+
+        /**
+         * Resets every node of the board and removes every obstacle
+         */
+        void reset()
+        {
+            std::fill(m_nodes.begin(), m_nodes.end(), T());
+        }
+
+        inline T& operator[](const std::uint32_t index) { return m_nodes[index]; }
+
+        inline const T& operator[](const std::uint32_t index) const { return m_nodes[index]; }
+
+        /**
+         * Returns the index of a valid coordinate
+         *
+         * @param c Coordinate of the node
+         * @return Index of the node
+         */
+        inline std::uint32_t getIndex(const Coordinate& c) const { return (std::uint32_t)m_layout.getIndex(c); }
+
+        /**
+         * Returns the coordinate of a node from its index
+         *
+         * @param index Index of the node
+         * @return Coordinate of the node
+         */
+        inline Coordinate getPosition(const std::uint32_t index) const { return m_layout.getPosition(index); }
+
+        inline size_t getTotalSize() const { return m_totalSize; }
+
+        inline const BoardLayout getLayout() const { return m_layout.getLayout(); }
+
+        /**
+         * Get the approximate memory used by the board
+         *
+         * @return The approximate memory used by the board, in bytes
+         */
+        size_t getMemoryUsage() const
+        {
+            return m_layout.getCapacity() * (sizeof(T) + sizeof(Cost));
+        }
+
+        inline const Coordinate getSize() const { return m_size; }
+
+        inline const Coordinate getStart() const { return m_start; }
+
+        inline const Coordinate getGoal() const { return m_goal; }
+
+        inline const bool isValidNode(const Coordinate& c) const
+        {
+            return c.first >= 0 && c.first < m_size.first && c.second >= 0 && c.second < m_size.second;
+        }
+
+        inline const bool isObstacle(const Coordinate& c) const
+        {
+            return isValidNode(c) && m_nodes[getIndex(c)].is(SlimNode::Obstacle);
+        }
+
+        /**
+         * Returns the state of the node at the coordinate given
+         *
+         * @param c Coordinate of the node
+         * @return The state of the node, free if the coordinate is not valid
+         */
+        inline const NodeState getState(const Coordinate& c) const
+        {
+            if (!isValidNode(c)) return NodeState::Free;
+
+            const auto& node = m_nodes[getIndex(c)];
+            return node.is(SlimNode::Obstacle) ? NodeState::Obstacle : node.is(SlimNode::Closed) ? NodeState::Closed
+                : node.is(SlimNode::Opened) ? NodeState::Opened : NodeState::Free;
+        }
+
+        /**
+         * Sets the node at the coordinate given as an obstacle or not, except the start and the goal
+         *
+         * @param c Coordinate in which the obstacle field is modified
+         * @param obstacle Wether we set it to be an obstacle or not
+         */
+        void setObstacle(const Coordinate& c, const bool obstacle = true)
+        {
+            if (isValidNode(c) && c != m_start && c != m_goal)
+            {
+                m_nodes[getIndex(c)].set(SlimNode::Obstacle, obstacle);
+            }
+        }
+
+        /**
+         * Sets every node of the board as an obstacle or not from a grid of the same size, except the start and the goal
+         *
+         * @param obstacles Grid with a bit per node
+         */
+        void setObstacles(const ObstacleGrid& obstacles)
+        {
+            if (obstacles.getSize() != m_size) return;
+
+            for (int i = 0; i < m_size.first; ++i)
+            {
+                for (int j = 0; j < m_size.second; ++j)
+                {
+                    m_nodes[getIndex({ i, j })].set(SlimNode::Obstacle, obstacles.test({ i, j }));
+                }
+            }
+
+            // The start and the goal can't be obstacles
+            if (isValidNode(m_start)) m_nodes[getIndex(m_start)].set(SlimNode::Obstacle, false);
+            if (isValidNode(m_goal)) m_nodes[getIndex(m_goal)].set(SlimNode::Obstacle, false);
+        }
+
+        inline const Cost getCost(const Coordinate& c) const
+        {
+            return isValidNode(c) ? m_costs[getIndex(c)] : 1;
+        }
+
+        inline const Cost getCost(const std::uint32_t index) const { return m_costs[index]; }
+
+        /**
+         * Sets the traversal cost of the node at the coordinate given. Costs are terrain data, so they are kept on reset
+         *
+         * @param c Coordinate in which the cost is modified
+         * @param cost Cost of moving into the node, at least 1
+         */
+        void setCost(const Coordinate& c, const Cost cost = 1)
+        {
+            if (!isValidNode(c)) return;
+
+            auto& current = m_costs[getIndex(c)];
+            const Cost next = std::max<Cost>(cost, 1);
+
+            --m_costCount[current];
+            ++m_costCount[next];
+            current = next;
+
+            // Only look for the new minimum if it could have changed
+            if (next < m_minCost)
+            {
+                m_minCost = next;
+            }
+            else if (!m_costCount[m_minCost])
+            {
+                while (!m_costCount[m_minCost]) ++m_minCost;
+            }
+        }
+
+        /**
+         * Sets the traversal cost of every node of the board from a collection of the same size
+         *
+         * @param costs Collection with the cost of every node, stored contiguously by axis
+         */
+        void setCosts(const std::vector<Cost>& costs)
+        {
+            if (costs.size() != m_totalSize) return;
+
+            m_costCount.fill(0);
+            for (int i = 0; i < m_size.first; ++i)
+            {
+                for (int j = 0; j < m_size.second; ++j)
+                {
+                    auto& cost = m_costs[getIndex({ i, j })];
+                    cost = std::max<Cost>(costs[(size_t)i * m_size.second + j], 1);
+                    ++m_costCount[cost];
+                }
+            }
+
+            for (m_minCost = 1; m_minCost < m_costCount.size() - 1 && !m_costCount[m_minCost]; ++m_minCost);
+        }
+
+        inline const Cost getMinCost() const { return m_minCost; }
+
+        /**
+         * Adds the accessible neighbors with the moves allowed, choosing the neighbor generator of the moves once per call
+         *
+         * @param index Index of the node from which the neighbors are returned
+         * @param neighbors Reference to the collection of neighbors to which they are added
+         * @param movement Moves allowed between neighbor nodes
+         */
+        void getNeighbors(const std::uint32_t index, std::vector<std::uint32_t>& neighbors, const Movement movement) const
+        {
+            switch (movement)
+            {
+                case Movement::Orthogonal:
+                    return getNeighbors<Movement::Orthogonal>(index, neighbors);
+
+                case Movement::Diagonal:
+                    return getNeighbors<Movement::Diagonal>(index, neighbors);
+
+                case Movement::DiagonalNoCornerCut:
+                    return getNeighbors<Movement::DiagonalNoCornerCut>(index, neighbors);
+            }
+        }
+
+        /**
+         * Adds the indexes of the accessible neighbors to the collection given, in the same order as the neighbors of Board
+         *
+         * @param index Index of the node from which the neighbors are returned
+         * @param neighbors Reference to the collection of neighbors to which they are added
+         */
+        template <Movement M>
+        void getNeighbors(const std::uint32_t index, std::vector<std::uint32_t>& neighbors) const
+        {
+            static constexpr std::array<Coordinate, 8> offsets{{
+                { 0, -1 }, { 1, 0 }, { 0, 1 }, { -1, 0 },       // North, East, South, West
+                { -1, -1 }, { 1, -1 }, { 1, 1 }, { -1, 1 }      // North West, North East, South East, South West
+            }};
+
+            const auto from = getPosition(index);
+
+            // Whether every orthogonal neighbor is accessible, to check the corners of the diagonal ones
+            bool accessible[4];
+            for (size_t i = 0; i < 4; ++i)
+            {
+                const Coordinate to{ from.first + offsets[i].first, from.second + offsets[i].second };
+                const auto toIndex = isValidNode(to) ? getIndex(to) : SlimNode::None;
+
+                accessible[i] = toIndex != SlimNode::None && !m_nodes[toIndex].is(SlimNode::Obstacle);
+                if (accessible[i]) neighbors.push_back(toIndex);
+            }
+
+            if constexpr (M == Movement::Orthogonal) return;
+
+            for (size_t i = 4; i < 8; ++i)
+            {
+                const Coordinate to{ from.first + offsets[i].first, from.second + offsets[i].second };
+                if (!isValidNode(to)) continue;
+
+                const auto toIndex = getIndex(to);
+                if (m_nodes[toIndex].is(SlimNode::Obstacle)) continue;
+
+                const bool contiguous1 = accessible[offsets[i].second < 0 ? 0 : 2];
+                const bool contiguous2 = accessible[offsets[i].first > 0 ? 1 : 3];
+                if (!IsDiagonalAllowed<M>(contiguous1, contiguous2)) continue;
+
+                neighbors.push_back(toIndex);
+            }
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,62 @@
+#ifndef STATISTICS_H
+#define STATISTICS_H
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+
+namespace Benchmark {
+
+    /// Summary of a collection of samples
+    struct Statistics
+    {
+        size_t count = 0;
+        double min = 0.f;
+        double max = 0.f;
+        double mean = 0.f;
+        double median = 0.f;
+        double p95 = 0.f;
+        double p99 = 0.f;
+        double stddev = 0.f;
+
+        Statistics() {}
+
+        Statistics(std::vector<double> samples)
+            : count(samples.size())
+        {
+            if (samples.empty()) return;
+
+            std::sort(samples.begin(), samples.end());
+
+            min = samples.front();
+            max = samples.back();
+            median = Percentile(samples, 50);
+            p95 = Percentile(samples, 95);
+            p99 = Percentile(samples, 99);
+
+            for (auto sample : samples)
+            {
+                mean += sample;
+            }
+            mean /= count;
+
+            for (auto sample : samples)
+            {
+                stddev += (sample - mean) * (sample - mean);
+            }
+            stddev = count > 1 ? std::sqrt(stddev / (count - 1)) : 0.f;
+        }
+
+    private:
+        /// Nearest-rank percentile of the sorted samples
+        static double Percentile(const std::vector<double>& sorted, const double percent)
+        {
+            auto rank = (size_t)std::ceil(percent / 100 * sorted.size());
+            return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+        }
+    };
+}
+
+#endif
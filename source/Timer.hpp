@@ -4,37 +4,49 @@
 
 #include <iostream>
 #include <chrono>
+#include <string>
 
 
 namespace Benchmark {
 
-    class Timer
+    /// Monotonic clock, so the measures are not affected by changes of the system time
+    typedef std::chrono::steady_clock                       steady_clock;
+
+    class Stopwatch
     {
-        typedef std::chrono::high_resolution_clock          hr_clock;
-        typedef std::chrono::time_point<hr_clock>           time_point;
-        typedef std::chrono::microseconds                   microseconds;
+        typedef std::chrono::time_point<steady_clock>       time_point;
+        typedef std::chrono::duration<double, std::micro>   microseconds;
 
     private:
-        const time_point m_start;
+        time_point m_start;
+
+    public:
+        Stopwatch()
+            : m_start(steady_clock::now()) {}
+
+        void Restart() { m_start = steady_clock::now(); }
+
+        double Elapsed() const { return microseconds(steady_clock::now() - m_start).count(); }
+    };
+
+    class Timer
+    {
+    private:
+        const Stopwatch m_stopwatch;
         const std::string m_title;
 
     public:
         Timer()
-            : m_start(hr_clock::now()), m_title("Unknown") {}
+            : m_title("Unknown") {}
 
         Timer(std::string title)
-            : m_start(hr_clock::now()), m_title(title) {}
+            : m_title(title) {}
 
         ~Timer() { Stop(); }
 
         void Stop()
         {
-            auto m_stop = hr_clock::now();
-
-            auto start = std::chrono::time_point_cast<microseconds>(m_start).time_since_epoch().count();
-            auto stop = std::chrono::time_point_cast<microseconds>(m_stop).time_since_epoch().count();
-
-            auto duration = stop - start;
+            auto duration = m_stopwatch.Elapsed();
             double ms = duration * 0.001;
 
             std::cout << "Timer: " << duration << "us (" << ms << "ms)" << std::endl;
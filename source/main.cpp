@@ -1,8 +1,18 @@
 #include "PathFinding/PathFinder.hpp"
 #include "PathFinding/Algorithms/AStar.hpp"
+#include "PathFinding/Algorithms/ARAStar.hpp"
+#include "PathFinding/Algorithms/BeamSearch.hpp"
 #include "PathFinding/Algorithms/BestFirstSearch.hpp"
 #include "PathFinding/Algorithms/BreadthFirstSearch.hpp"
 #include "PathFinding/Algorithms/DepthFirstSearch.hpp"
+#include "PathFinding/Algorithms/Dijkstra.hpp"
+#include "PathFinding/Algorithms/LazyThetaStar.hpp"
+#include "PathFinding/Algorithms/ParallelAStar.hpp"
+#include "PathFinding/Algorithms/ParallelBreadthFirstSearch.hpp"
+#include "PathFinding/Algorithms/SlimAStar.hpp"
+#include "PathFinding/Algorithms/ChunkedAStar.hpp"
+#include "PathFinding/Algorithms/QuadtreeAStar.hpp"
+#include "PathFinding/Algorithms/FixedAStar.hpp"
 
 
 int main()
@@ -11,7 +21,7 @@ int main()
     
     
     // Store the Board parameters
-    Coordinate size { 25, 5 };
+    constexpr Coordinate size { 25, 5 };
     Coordinate start { 1, size.second / 2 };
     Coordinate goal { size.first - 2, size.second / 2 };
     
@@ -20,8 +30,12 @@ int main()
     RunMode runMode = RunMode::Timer;
     
     
+    // Whether the layouts of Slim A* are benchmarked on a big board before anything else, the results are on the README
+    bool compareLayouts = false;
+    
+    
     // Store the PathFinding Algorithm parameters
-    Heuristic heuristic = Heuristic::Manhattan;
+    Heuristic heuristic = Heuristic::Diagonal;
     bool diagonals = true;
     bool cutCorners = true;
     
@@ -29,6 +43,29 @@ int main()
     // Init the A* Algorithm
     PathFinder pathFinder(std::make_unique<AStar>(size, start, goal));
     
+    
+    // Store the Algorithms raced on Portfolio mode, the first one to find a solution wins. A* is only optimal with an admissible heuristic
+    pathFinder.addRacer(std::make_unique<AStar>(size, start, goal), IsAdmissible(heuristic, diagonals));
+    pathFinder.addRacer(std::make_unique<BestFirstSearch>(size, start, goal));
+    pathFinder.addRacer(std::make_unique<BreadthFirstSearch>(size, start, goal));
+    pathFinder.addRacer(std::make_unique<DepthFirstSearch>(size, start, goal));
+    
+    // Benchmark Slim A* with every layout on the same board, without printing it
+    if (compareLayouts)
+    {
+        constexpr Coordinate layoutSize { 2048, 2048 };
+        for (const auto layout : { BoardLayout::Linear, BoardLayout::Tiled, BoardLayout::Morton })
+        {
+            PathFinder layoutFinder(std::make_unique<SlimAStar>(layoutSize, Coordinate{ 0, 0 }, Coordinate{ layoutSize.first - 1, layoutSize.second - 1 }, layout));
+            layoutFinder.setConsoleOutput(false);
+            layoutFinder.setGeneratedObstacles(ObstaclePattern::CityBlocks, 1, 0.3);
+            layoutFinder.setBenchmarkRuns(1, 5);
+            
+            std::cout << "Layout: " << (layout == BoardLayout::Linear ? "Linear" : layout == BoardLayout::Tiled ? "Tiled" : "Morton") << std::endl;
+            layoutFinder.run(RunMode::Benchmark, heuristic, diagonals, cutCorners);
+        }
+    }
+    
     while (true)
     {
         // Set rand obstacles and run it
@@ -41,16 +78,75 @@ int main()
         pathFinder.run(runMode, heuristic, diagonals, cutCorners);
         
         
+        // Set the Beam Search Algorithm and run it with same obstacles as last algorithm
+        pathFinder.setAlgorithm(std::make_unique<BeamSearch>(size, start, goal));
+        pathFinder.run(runMode, heuristic, diagonals, cutCorners);
+        
+        
         // Set the Breadth First Search Algorithm and run it with same obstacles as last algorithm
         pathFinder.setAlgorithm(std::make_unique<BreadthFirstSearch>(size, start, goal));
         pathFinder.run(runMode, heuristic, diagonals, cutCorners);
         
         
+        // Set the Parallel Breadth First Search Algorithm and run it with same obstacles as last algorithm
+        pathFinder.setAlgorithm(std::make_unique<ParallelBreadthFirstSearch>(size, start, goal));
+        pathFinder.run(runMode, heuristic, diagonals, cutCorners);
+        
+        
         // Set the Depth First Search Algorithm and run it with same obstacles as last algorithm
         pathFinder.setAlgorithm(std::make_unique<DepthFirstSearch>(size, start, goal));
         pathFinder.run(runMode, heuristic, diagonals, cutCorners);
         
         
+        // Set the Dijkstra Algorithm and run it with same obstacles as last algorithm
+        pathFinder.setAlgorithm(std::make_unique<Dijkstra>(size, start, goal));
+        pathFinder.run(runMode, heuristic, diagonals, cutCorners);
+        
+        
+        // Set the ARA* Algorithm and run it with same obstacles as last algorithm
+        pathFinder.setAlgorithm(std::make_unique<ARAStar>(size, start, goal));
+        pathFinder.run(runMode, heuristic, diagonals, cutCorners);
+        
+        
+        // Set the HDA* Algorithm and run it with same obstacles as last algorithm
+        pathFinder.setAlgorithm(std::make_unique<ParallelAStar>(size, start, goal));
+        pathFinder.run(runMode, heuristic, diagonals, cutCorners);
+        
+        
+        // Set the Slim A* Algorithm and run it with same obstacles as last algorithm
+        pathFinder.setAlgorithm(std::make_unique<SlimAStar>(size, start, goal));
+        pathFinder.run(runMode, heuristic, diagonals, cutCorners);
+        
+        
+        // Set the Chunked A* Algorithm and run it with same obstacles as last algorithm
+        pathFinder.setAlgorithm(std::make_unique<ChunkedAStar>(size, start, goal));
+        pathFinder.run(runMode, heuristic, diagonals, cutCorners);
+        
+        
+        // Set the Quadtree A* Algorithm, which is not optimal, and run it with same obstacles as last algorithm
+        pathFinder.setAlgorithm(std::make_unique<QuadtreeAStar>(size, start, goal));
+        pathFinder.run(runMode, heuristic, diagonals, cutCorners);
+        
+        
+        // Set the Fixed A* Algorithm and run it with same obstacles as last algorithm
+        pathFinder.setAlgorithm(std::make_unique<FixedAStar<size.first, size.second>>(start, goal));
+        pathFinder.run(runMode, heuristic, diagonals, cutCorners);
+        
+        
+        // Set the Theta* Algorithm and run it with same obstacles as last algorithm
+        pathFinder.setAlgorithm(std::make_unique<ThetaStar>(size, start, goal));
+        pathFinder.run(runMode, heuristic, diagonals, cutCorners);
+        
+        
+        // Set the Lazy Theta* Algorithm and run it with same obstacles as last algorithm
+        pathFinder.setAlgorithm(std::make_unique<LazyThetaStar>(size, start, goal));
+        pathFinder.run(runMode, heuristic, diagonals, cutCorners);
+        
+        
+        // Race the Algorithms of the portfolio with same obstacles as last algorithm
+        pathFinder.run(RunMode::Portfolio, heuristic, diagonals, cutCorners);
+        
+        
         // Set the A* Algorithm
         pathFinder.setAlgorithm(std::make_unique<AStar>(size, start, goal));
     }